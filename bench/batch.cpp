@@ -0,0 +1,44 @@
+#include "bench_util.hpp"
+
+static const bit::sl_set<int> &get_large_list() {
+    static bit::sl_set<int> sls = [] {
+        auto v = bit::get_bench_vector(1 << 21);
+        std::sort(v.begin(), v.end());
+        bit::sl_set<int> tmp;
+        tmp.assign_sorted(v.begin(), v.end());
+        return tmp;
+    }();
+    return sls;
+}
+
+static void BM_find_unsorted_loop(benchmark::State &state) {
+    const auto &sls = get_large_list();
+    auto keys = bit::get_bench_vector(state.range(0), 1);
+
+    std::vector<bit::sl_set<int>::iterator> out(keys.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            out[i] = sls.find(keys[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_find_unsorted_loop)->Arg(1 << 14);
+
+template <std::size_t Group>
+static void BM_find_interleaved(benchmark::State &state) {
+    const auto &sls = get_large_list();
+    auto keys = bit::get_bench_vector(state.range(0), 1);
+
+    std::vector<bit::sl_set<int>::iterator> out(keys.size());
+    for (auto _ : state) {
+        sls.find_interleaved<Group>(keys.begin(), keys.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK_TEMPLATE(BM_find_interleaved, 4)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(BM_find_interleaved, 8)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(BM_find_interleaved, 16)->Arg(1 << 14);
+BENCHMARK_TEMPLATE(BM_find_interleaved, 32)->Arg(1 << 14);
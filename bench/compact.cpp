@@ -0,0 +1,51 @@
+#include "bench_util.hpp"
+#include "compact_skip_list.hpp"
+
+template <typename T>
+using csl_set = bit::CompactSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename SL>
+static void BM_compact_find(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_compact_find, bit::sl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+BENCHMARK_TEMPLATE(BM_compact_find, csl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+
+template <typename SL>
+static void BM_compact_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    for (auto _ : state) {
+        SL sls;
+        for (const auto &i : v) {
+            sls.insert_equal(i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_compact_insert, bit::sl_set<int>)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_compact_insert, csl_set<int>)->Arg(1 << 18);
+
+static void BM_compact_bytes_per_element(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    std::size_t bytes = 0;
+    std::size_t fit = 0;
+    for (auto _ : state) {
+        csl_set<int> sls(v.begin(), v.end());
+        bytes = sls.arena_bytes();
+        sls.shrink_to_fit();
+        fit = sls.arena_bytes();
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.counters["bytes/elem"] = (double)bytes / v.size();
+    state.counters["fit_bytes/elem"] = (double)fit / v.size();
+}
+BENCHMARK(BM_compact_bytes_per_element)->Arg(1 << 16)->Arg(1 << 20);
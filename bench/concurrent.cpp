@@ -0,0 +1,75 @@
+#include "bench_util.hpp"
+#include "concurrent_skip_list.hpp"
+#include "lazy_skip_list.hpp"
+
+template <typename T>
+using csl_set = bit::ConcurrentSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename T>
+using lsl_set = bit::LazySkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+constexpr int CONCURRENT_KEYS = 1 << 16;
+
+/*
+ * 每个线程执行 90% 查找、5% 插入、5% 删除，键取自 [0, 2 * CONCURRENT_KEYS)
+ */
+template <typename SL>
+static void BM_concurrent_mixed(benchmark::State &state) {
+    static SL *sls = nullptr;
+    if (state.thread_index() == 0) {
+        sls = new SL();
+        for (int i = 0; i < 2 * CONCURRENT_KEYS; i += 2) {
+            sls->insert_unique(i);
+        }
+    }
+
+    std::default_random_engine dre(state.thread_index());
+    std::uniform_int_distribution<int> uid(0, 2 * CONCURRENT_KEYS - 1);
+    std::uint32_t op = 0;
+    for (auto _ : state) {
+        int key = uid(dre);
+        switch (op++ % 20) {
+        case 0:
+            benchmark::DoNotOptimize(sls->insert_unique(key));
+            break;
+        case 1:
+            benchmark::DoNotOptimize(sls->erase(key));
+            break;
+        default:
+            benchmark::DoNotOptimize(sls->contain(key));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        delete sls;
+    }
+}
+BENCHMARK_TEMPLATE(BM_concurrent_mixed, bit::MutexSkipList<int>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_concurrent_mixed, csl_set<int>)->ThreadRange(1, 32)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_concurrent_mixed, lsl_set<int>)->ThreadRange(1, 32)->UseRealTime();
+
+template <typename SL>
+static void BM_concurrent_find(benchmark::State &state) {
+    static SL *sls = nullptr;
+    if (state.thread_index() == 0) {
+        sls = new SL();
+        for (int i = 0; i < CONCURRENT_KEYS; ++i) {
+            sls->insert_unique(i);
+        }
+    }
+
+    std::default_random_engine dre(state.thread_index());
+    std::uniform_int_distribution<int> uid(0, CONCURRENT_KEYS - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls->contain(uid(dre)));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        delete sls;
+    }
+}
+BENCHMARK_TEMPLATE(BM_concurrent_find, bit::MutexSkipList<int>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_concurrent_find, csl_set<int>)->ThreadRange(1, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_concurrent_find, lsl_set<int>)->ThreadRange(1, 4)->UseRealTime();
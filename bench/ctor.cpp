@@ -0,0 +1,61 @@
+#include "bench_util.hpp"
+
+static void BM_copy_ctor(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    bit::sl_set<int> sls(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> other(sls);
+        benchmark::DoNotOptimize(other.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_copy_ctor)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+static void BM_build_sorted_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> sls(v.begin(), v.end());
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_build_sorted_insert)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+static void BM_build_sorted_assign(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> sls;
+        sls.assign_sorted(v.begin(), v.end());
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_build_sorted_assign)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+static void BM_build_random_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    for (auto _ : state) {
+        bit::sl_set<int> sls(v.begin(), v.end());
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_build_random_insert)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+
+static void BM_build_parallel(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    for (auto _ : state) {
+        auto sls = bit::sl_set<int>::build_parallel(v.begin(), v.end(), state.range(1));
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_build_parallel)->Args({ 1 << 20, 1 })->Args({ 1 << 20, 2 })->Args({ 1 << 20, 4 })
+    ->Unit(benchmark::kMillisecond)->UseRealTime();
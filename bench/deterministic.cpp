@@ -0,0 +1,109 @@
+#include <chrono>
+
+#include "bench_util.hpp"
+#include "deterministic_skip_list.hpp"
+
+namespace {
+
+inline std::size_t compares = 0;
+
+struct CountingLess {
+    bool operator()(int a, int b) const {
+        ++compares;
+        return a < b;
+    }
+};
+
+using random_set = bit::SkipList<int, int, std::_Identity<int>, CountingLess>;
+using deterministic_set =
+    bit::DeterministicSkipList<int, int, std::_Identity<int>, CountingLess>;
+
+template <typename T>
+double percentile(std::vector<T> &v, double p) {
+    auto nth = v.begin() + (std::size_t)(p * (v.size() - 1));
+    std::nth_element(v.begin(), nth, v.end());
+    return (double)*nth;
+}
+
+}
+
+/*
+ * 先插入 2n 个元素再删除一半，得到经过插入与删除的表
+ */
+template <typename SL>
+static void build(SL &sls, std::size_t n) {
+    auto v = bit::get_bench_vector(2 * n);
+    for (const auto &i : v) {
+        sls.insert_equal(i);
+    }
+    for (std::size_t i = 0; i < v.size(); i += 2) {
+        sls.erase(v[i]);
+    }
+}
+
+template <typename SL>
+static void BM_balance_search(benchmark::State &state) {
+    SL sls;
+    build(sls, state.range(0));
+    auto v = bit::get_bench_vector(2 * state.range(0));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_balance_search, random_set)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_balance_search, deterministic_set)->Arg(1 << 12)->Arg(1 << 18);
+
+/*
+ * 逐个计时每次查找并统计比较次数，报告分位数
+ */
+template <typename SL>
+static void BM_balance_search_tail(benchmark::State &state) {
+    SL sls;
+    build(sls, state.range(0));
+    auto v = bit::get_bench_vector(2 * state.range(0));
+
+    std::vector<std::size_t> cmp(v.size());
+    std::vector<long> ns(v.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            auto start = std::chrono::steady_clock::now();
+            compares = 0;
+            benchmark::DoNotOptimize(sls.find(v[i]));
+            cmp[i] = compares;
+            ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+    state.counters["ns_p50"] = percentile(ns, 0.5);
+    state.counters["ns_p99"] = percentile(ns, 0.99);
+    state.counters["ns_p999"] = percentile(ns, 0.999);
+    state.counters["cmp_p50"] = percentile(cmp, 0.5);
+    state.counters["cmp_p999"] = percentile(cmp, 0.999);
+    state.counters["cmp_max"] = (double)*std::max_element(cmp.begin(), cmp.end());
+    state.counters["height"] = sls.height();
+}
+BENCHMARK_TEMPLATE(BM_balance_search_tail, random_set)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_balance_search_tail, deterministic_set)->Arg(1 << 12)->Arg(1 << 18);
+
+template <typename SL>
+static void BM_balance_insert_erase(benchmark::State &state) {
+    SL sls;
+    build(sls, state.range(0));
+    auto batch = bit::get_bench_vector(1024, 1);
+
+    for (auto _ : state) {
+        for (const auto &i : batch) {
+            sls.insert_equal(i);
+        }
+        for (const auto &i : batch) {
+            sls.erase(i);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size() * 2);
+}
+BENCHMARK_TEMPLATE(BM_balance_insert_erase, random_set)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_balance_insert_erase, deterministic_set)->Arg(1 << 12)->Arg(1 << 18);
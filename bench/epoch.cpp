@@ -0,0 +1,28 @@
+#include "bench_util.hpp"
+
+static void BM_epoch_pin(benchmark::State &state) {
+    bit::EpochDomain domain;
+    for (auto _ : state) {
+        auto guard = domain.pin();
+        benchmark::DoNotOptimize(guard);
+    }
+}
+BENCHMARK(BM_epoch_pin);
+
+/*
+ * 删除后立即重新插入，比较立即释放与延迟回收的开销
+ */
+static void BM_epoch_erase_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    bit::sl_published_set<int> sls(v.begin(), v.end());
+    sls.enable_epoch(state.range(1));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        int key = v[i++ % v.size()];
+        sls.erase(sls.find(key));
+        sls.insert_equal(key);
+    }
+    state.counters["retired"] = sls.retired();
+}
+BENCHMARK(BM_epoch_erase_insert)->Args({ 1 << 16, 0 })->Args({ 1 << 16, 1 });
@@ -0,0 +1,41 @@
+#include "bench_util.hpp"
+
+template <typename SL>
+static void BM_clear(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        SL sls;
+        sls.assign_sorted(v.begin(), v.end());
+        state.ResumeTiming();
+
+        sls.clear();
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_clear, bit::sl_set<int>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_clear, bit::SkipList<int, int, std::_Identity<int>,
+    std::less<int>, 32, std::allocator<int>>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+static void BM_erase_range(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+    bit::sl_set<int> sls;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        sls.assign_sorted(v.begin(), v.end());
+        auto first = sls.lower_bound(v[v.size() / 4]);
+        auto last = sls.lower_bound(v[v.size() * 3 / 4]);
+        state.ResumeTiming();
+
+        benchmark::DoNotOptimize(sls.erase(first, last));
+    }
+    state.SetItemsProcessed(state.iterations() * v.size() / 2);
+}
+BENCHMARK(BM_erase_range)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
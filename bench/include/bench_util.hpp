@@ -0,0 +1,97 @@
+#ifndef _BENCH_UTIL_HPP__
+#define _BENCH_UTIL_HPP__
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "skip_list.hpp"
+
+namespace bit {
+
+template <typename T>
+using sl_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename T>
+using sl_indexed_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, bit::IndexedLinkPolicy>;
+
+template <typename T>
+using sl_published_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, bit::PublishedLinkPolicy>;
+
+inline std::size_t allocated_bytes = 0;
+
+/*
+ * 统计节点占用的字节数
+ */
+template <typename T>
+struct CountingAllocator : public std::allocator<T> {
+    template <typename U>
+    struct rebind {
+        using other = CountingAllocator<U>;
+    };
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &) {
+    }
+
+    T *allocate(std::size_t n) {
+        allocated_bytes += n * sizeof(T);
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        allocated_bytes -= n * sizeof(T);
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+inline std::vector<int> get_bench_vector(std::size_t size, uint32_t seed = 0) {
+    std::default_random_engine dre(seed);
+    std::uniform_int_distribution<> uid;
+    std::vector<int> v(size);
+    for (auto &i : v) {
+        i = uid(dre);
+    }
+    return v;
+}
+
+/*
+ * 用一把互斥锁保护的普通跳表，作为对照
+ */
+template <typename T>
+class MutexSkipList {
+public:
+    bool contain(const T &key) const {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        return m_sls_.contain(key);
+    }
+
+    bool insert_unique(const T &value) {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        return m_sls_.insert_unique(value).second;
+    }
+
+    bool erase(const T &key) {
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        auto it = m_sls_.find(key);
+        if (it == m_sls_.end()) {
+            return false;
+        }
+        m_sls_.erase(it);
+        return true;
+    }
+private:
+    mutable std::mutex m_mutex_;
+    sl_set<T> m_sls_;
+};
+
+}
+
+#endif // _BENCH_UTIL_HPP__
@@ -0,0 +1,67 @@
+#include "bench_util.hpp"
+
+static void BM_insert_sorted(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> sls;
+        for (const auto &i : v) {
+            sls.insert_equal(i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_insert_sorted)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+
+static void BM_insert_sorted_hint(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> sls;
+        for (const auto &i : v) {
+            sls.insert_equal(sls.end(), i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK(BM_insert_sorted_hint)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+
+static void BM_insert_batch_loop(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 18);
+    auto batch = bit::get_bench_vector(state.range(0), 1);
+    std::sort(batch.begin(), batch.end());
+
+    bit::sl_set<int> sls(v.begin(), v.end());
+    for (auto _ : state) {
+        for (const auto &i : batch) {
+            sls.insert_equal(i);
+        }
+        state.PauseTiming();
+        for (const auto &i : batch) {
+            sls.erase(i);
+        }
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_insert_batch_loop)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
+
+static void BM_insert_batch(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 18);
+    auto batch = bit::get_bench_vector(state.range(0), 1);
+    std::sort(batch.begin(), batch.end());
+
+    bit::sl_set<int> sls(v.begin(), v.end());
+    for (auto _ : state) {
+        sls.insert_equal_batch(batch.begin(), batch.end());
+        state.PauseTiming();
+        sls.erase_batch(batch.begin(), batch.end());
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batch.size());
+}
+BENCHMARK(BM_insert_batch)->RangeMultiplier(8)->Range(1 << 9, 1 << 15);
@@ -0,0 +1,41 @@
+#include "bench_util.hpp"
+
+template <typename LevelGenerator>
+using sl_generator_set = bit::SkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+    bit::SkipListPool<int>, bit::DefaultLinkPolicy, LevelGenerator>;
+
+/*
+ * 单独生成塔高的开销
+ */
+template <typename LevelGenerator>
+static void BM_level_generate(benchmark::State &state) {
+    LevelGenerator lg(0.5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(lg());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_level_generate, bit::GeometricLevelGenerator);
+BENCHMARK_TEMPLATE(BM_level_generate, bit::XorshiftLevelGenerator<>);
+BENCHMARK_TEMPLATE(BM_level_generate, bit::SeededLevelGenerator<>);
+
+/*
+ * 有序插入时查找开销小，塔高生成在插入中的占比最大
+ */
+template <typename LevelGenerator>
+static void BM_level_insert_sorted(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+
+    for (auto _ : state) {
+        sl_generator_set<LevelGenerator> sls;
+        for (const auto &i : v) {
+            sls.insert_equal(sls.end(), i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_level_insert_sorted, bit::GeometricLevelGenerator)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_level_insert_sorted, bit::XorshiftLevelGenerator<>)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK_TEMPLATE(BM_level_insert_sorted, bit::SeededLevelGenerator<>)->Arg(1 << 12)->Arg(1 << 18);
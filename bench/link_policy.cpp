@@ -0,0 +1,64 @@
+#include "bench_util.hpp"
+
+template <typename LinkPolicy, typename Allocator = bit::SkipListPool<int>>
+using sl_policy_set = bit::SkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+    Allocator, LinkPolicy>;
+
+template <typename SL>
+static void BM_policy_find(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_policy_find, sl_policy_set<bit::DefaultLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_policy_find, sl_policy_set<bit::BottomBackwardLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_policy_find, sl_policy_set<bit::ForwardLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+template <typename SL>
+static void BM_policy_insert_erase(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    auto keys = bit::get_bench_vector(4096, 1);
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        int key = keys[i++ & 4095];
+        sls.erase(sls.insert_equal(key));
+    }
+}
+BENCHMARK_TEMPLATE(BM_policy_insert_erase, sl_policy_set<bit::DefaultLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_policy_insert_erase, sl_policy_set<bit::BottomBackwardLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_policy_insert_erase, sl_policy_set<bit::ForwardLinkPolicy>)
+    ->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+template <typename SL>
+static void BM_policy_bytes_per_element(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        bit::allocated_bytes = 0;
+        SL sls(v.begin(), v.end());
+        bytes = bit::allocated_bytes;
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.counters["bytes/elem"] = (double)bytes / v.size();
+}
+BENCHMARK_TEMPLATE(BM_policy_bytes_per_element,
+                   sl_policy_set<bit::DefaultLinkPolicy, bit::CountingAllocator<int>>)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_policy_bytes_per_element,
+                   sl_policy_set<bit::BottomBackwardLinkPolicy, bit::CountingAllocator<int>>)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_policy_bytes_per_element,
+                   sl_policy_set<bit::ForwardLinkPolicy, bit::CountingAllocator<int>>)
+    ->Arg(1 << 16);
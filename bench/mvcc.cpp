@@ -0,0 +1,61 @@
+#include "bench_util.hpp"
+#include "mvcc_skip_list.hpp"
+
+template <typename T>
+using mvcc_set = bit::MvccSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+/*
+ * 取得一致的视图后扫描 state.range(0) 个元素：拷贝整个表与创建快照
+ */
+static void BM_consistent_scan_copy(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    bit::sl_set<int> sls(v.begin(), v.end());
+
+    for (auto _ : state) {
+        bit::sl_set<int> copy(sls);
+        long sum = 0;
+        for (int i : copy) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_consistent_scan_copy)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_consistent_scan_snapshot(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    mvcc_set<int> sls;
+    for (int i : v) {
+        sls.insert_unique(i);
+    }
+
+    for (auto _ : state) {
+        auto snapshot = sls.snapshot();
+        long sum = 0;
+        for (int i : snapshot) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_consistent_scan_snapshot)->Arg(1 << 12)->Arg(1 << 18);
+
+/*
+ * 覆盖写已有的键，每次写入都产生一个新版本并截下旧版本
+ */
+static void BM_mvcc_assign(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    mvcc_set<int> sls;
+    for (int i : v) {
+        sls.insert_unique(i);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.insert_or_assign(v[i++ % v.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_mvcc_assign)->Arg(1 << 12)->Arg(1 << 18);
@@ -0,0 +1,80 @@
+#include <mutex>
+#include <shared_mutex>
+
+#include "bench_util.hpp"
+
+template <typename SL>
+static void BM_published_find(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_published_find, bit::sl_set<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_published_find, bit::sl_published_set<int>)->Arg(1 << 16);
+
+template <typename SL>
+static void BM_published_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    for (auto _ : state) {
+        SL sls;
+        for (const auto &i : v) {
+            sls.insert_equal(i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_published_insert, bit::sl_set<int>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_published_insert, bit::sl_published_set<int>)->Arg(1 << 16);
+
+constexpr int PUBLISHED_KEYS = 1 << 16;
+
+/*
+ * 线程 0 持续插入，其余线程查找；Locked 为 true 时读写都经过读写锁
+ */
+template <typename SL, bool Locked>
+static void BM_published_read_write(benchmark::State &state) {
+    static SL *sls = nullptr;
+    static std::shared_mutex mutex;
+    if (state.thread_index() == 0) {
+        sls = new SL();
+        for (int i = 0; i < PUBLISHED_KEYS; ++i) {
+            sls->insert_equal(i * 2);
+        }
+    }
+
+    std::default_random_engine dre(state.thread_index());
+    std::uniform_int_distribution<int> uid(0, 2 * PUBLISHED_KEYS - 1);
+    for (auto _ : state) {
+        int key = uid(dre);
+        if (state.thread_index() == 0) {
+            if constexpr (Locked) {
+                std::unique_lock<std::shared_mutex> lock(mutex);
+                sls->insert_equal(key);
+            } else {
+                sls->insert_equal(key);
+            }
+        } else {
+            if constexpr (Locked) {
+                std::shared_lock<std::shared_mutex> lock(mutex);
+                benchmark::DoNotOptimize(sls->find(key));
+            } else {
+                benchmark::DoNotOptimize(sls->find(key));
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        delete sls;
+    }
+}
+BENCHMARK_TEMPLATE(BM_published_read_write, bit::sl_set<int>, true)
+    ->ThreadRange(2, 4)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_published_read_write, bit::sl_published_set<int>, false)
+    ->ThreadRange(2, 4)->UseRealTime();
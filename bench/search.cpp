@@ -0,0 +1,86 @@
+#include "bench_util.hpp"
+
+static void BM_lower_bound(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    bit::sl_set<int> sls(v.begin(), v.end());
+    auto keys = bit::get_bench_vector(4096, 1);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.lower_bound(keys[i++ & 4095]));
+    }
+}
+BENCHMARK(BM_lower_bound)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+static void BM_find(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    bit::sl_set<int> sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+}
+BENCHMARK(BM_find)->RangeMultiplier(8)->Range(8, 1 << 18);
+
+static void BM_find_sequential(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+    bit::sl_set<int> sls(v.begin(), v.end());
+    sls.enable_finger(state.range(1));
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+    state.counters["reused"] = sls.finger_stats().searches ?
+        (double)sls.finger_stats().reused / sls.finger_stats().searches : 0;
+}
+BENCHMARK(BM_find_sequential)->ArgsProduct({ { 1 << 12, 1 << 18 }, { 0, 1 } });
+
+template <typename SL>
+static void BM_nth(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.nth(v[i++ & 4095] % v.size()));
+    }
+}
+BENCHMARK_TEMPLATE(BM_nth, bit::sl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 15);
+BENCHMARK_TEMPLATE(BM_nth, bit::sl_indexed_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+static void BM_find_loop(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 18);
+    bit::sl_set<int> sls(v.begin(), v.end());
+    auto keys = bit::get_bench_vector(state.range(0), 1);
+    std::copy_n(v.begin(), keys.size() / 2, keys.begin());
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<bit::sl_set<int>::iterator> out(keys.size());
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            out[i] = sls.find(keys[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_find_loop)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
+
+static void BM_find_many(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 18);
+    bit::sl_set<int> sls(v.begin(), v.end());
+    auto keys = bit::get_bench_vector(state.range(0), 1);
+    std::copy_n(v.begin(), keys.size() / 2, keys.begin());
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<bit::sl_set<int>::iterator> out(keys.size());
+    for (auto _ : state) {
+        sls.find_many(keys.begin(), keys.end(), out.begin());
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+BENCHMARK(BM_find_many)->RangeMultiplier(8)->Range(1 << 8, 1 << 17);
@@ -0,0 +1,62 @@
+#include "bench_util.hpp"
+
+/*
+ * 两个各有 state.range(0) 个随机元素的表，计时部分只包含集合运算本身
+ */
+template <typename F>
+static void run_set_algebra(benchmark::State &state, F f) {
+    auto av = bit::get_bench_vector(state.range(0), 1);
+    auto bv = bit::get_bench_vector(state.range(0), 2);
+    std::sort(av.begin(), av.end());
+    std::sort(bv.begin(), bv.end());
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        bit::sl_set<int> a, b;
+        a.assign_sorted(av.begin(), av.end());
+        b.assign_sorted(bv.begin(), bv.end());
+        state.ResumeTiming();
+
+        f(a, b);
+        benchmark::DoNotOptimize(a.size());
+
+        state.PauseTiming();
+        a.clear();
+        b.clear();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * state.range(0));
+}
+
+static void BM_merge_insert_loop(benchmark::State &state) {
+    run_set_algebra(state, [](bit::sl_set<int> &a, bit::sl_set<int> &b) {
+        for (int i : b) {
+            a.insert_equal(i);
+        }
+        b.clear();
+    });
+}
+BENCHMARK(BM_merge_insert_loop)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_merge(benchmark::State &state) {
+    run_set_algebra(state, [](bit::sl_set<int> &a, bit::sl_set<int> &b) {
+        a.merge(b);
+    });
+}
+BENCHMARK(BM_merge)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_set_intersection_erase_loop(benchmark::State &state) {
+    run_set_algebra(state, [](bit::sl_set<int> &a, bit::sl_set<int> &b) {
+        for (auto it = a.begin(); it != a.end();) {
+            it = b.contain(*it) ? ++it : a.erase(it);
+        }
+    });
+}
+BENCHMARK(BM_set_intersection_erase_loop)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_set_intersection(benchmark::State &state) {
+    run_set_algebra(state, [](bit::sl_set<int> &a, bit::sl_set<int> &b) {
+        a.set_intersection(b);
+    });
+}
+BENCHMARK(BM_set_intersection)->Arg(1 << 12)->Arg(1 << 18);
@@ -0,0 +1,88 @@
+#include "bench_util.hpp"
+#include "sharded_skip_list.hpp"
+
+constexpr int SHARDED_SHARDS = 8;
+constexpr int SHARDED_RANGE = 1 << 24;
+
+template <typename T>
+class sl_sharded_set : public bit::ShardedSkipList<T, T, std::_Identity<T>, std::less<T>> {
+public:
+    sl_sharded_set() : bit::ShardedSkipList<T, T, std::_Identity<T>, std::less<T>>(get_bounds()) {
+    }
+private:
+    static std::vector<T> get_bounds() {
+        std::vector<T> bounds;
+        for (int i = 1; i < SHARDED_SHARDS; ++i) {
+            bounds.push_back(SHARDED_RANGE / SHARDED_SHARDS * i);
+        }
+        return bounds;
+    }
+};
+
+/*
+ * 每个线程向 [0, SHARDED_RANGE) 中插入随机键
+ */
+template <typename SL>
+static void BM_sharded_insert(benchmark::State &state) {
+    static SL *sls = nullptr;
+    if (state.thread_index() == 0) {
+        sls = new SL();
+    }
+
+    std::default_random_engine dre(state.thread_index());
+    std::uniform_int_distribution<int> uid(0, SHARDED_RANGE - 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls->insert_unique(uid(dre)));
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        delete sls;
+    }
+}
+BENCHMARK_TEMPLATE(BM_sharded_insert, bit::MutexSkipList<int>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_sharded_insert, sl_sharded_set<int>)->ThreadRange(1, 8)->UseRealTime();
+
+/*
+ * 扫描长度为 state.range(0) 的键区间，区间可能跨越分片边界
+ */
+static void BM_sharded_scan(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 16);
+    for (auto &i : v) {
+        i %= SHARDED_RANGE;
+    }
+    sl_sharded_set<int> sls;
+    for (const auto &i : v) {
+        sls.insert_equal(i);
+    }
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        int first = v[i++ % v.size()];
+        std::size_t n = 0;
+        sls.scan(first, first + state.range(0), [&n](int) {
+            ++n;
+        });
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_sharded_scan)->Arg(1 << 12)->Arg(1 << 20);
+
+static void BM_sharded_scan_baseline(benchmark::State &state) {
+    auto v = bit::get_bench_vector(1 << 16);
+    for (auto &i : v) {
+        i %= SHARDED_RANGE;
+    }
+    bit::sl_set<int> sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        int first = v[i++ % v.size()];
+        std::size_t n = 0;
+        for (auto it = sls.lower_bound(first); it != sls.end() && *it < first + state.range(0); ++it) {
+            ++n;
+        }
+        benchmark::DoNotOptimize(n);
+    }
+}
+BENCHMARK(BM_sharded_scan_baseline)->Arg(1 << 12)->Arg(1 << 20);
@@ -0,0 +1,55 @@
+#include "bench_util.hpp"
+
+/*
+ * 在中位键处把 state.range(0) 个元素的表一分为二，再拼接回去
+ */
+static void BM_split_join(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+    bit::sl_set<int> sls;
+    sls.assign_sorted(v.begin(), v.end());
+    int key = v[v.size() / 2];
+
+    for (auto _ : state) {
+        auto upper = sls.split(key);
+        benchmark::DoNotOptimize(upper.size());
+        sls.join(upper);
+    }
+}
+BENCHMARK(BM_split_join)->Arg(1 << 12)->Arg(1 << 18);
+
+static void BM_split_join_indexed(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+    bit::sl_indexed_set<int> sls;
+    sls.assign_sorted(v.begin(), v.end());
+    int key = v[v.size() / 2];
+
+    for (auto _ : state) {
+        auto upper = sls.split(key);
+        benchmark::DoNotOptimize(upper.size());
+        sls.join(upper);
+    }
+}
+BENCHMARK(BM_split_join_indexed)->Arg(1 << 12)->Arg(1 << 18);
+
+/*
+ * 对照：把上半部分移入新表后从原表删除，再逐个插入回去
+ */
+static void BM_split_join_copy(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    std::sort(v.begin(), v.end());
+    bit::sl_set<int> sls;
+    sls.assign_sorted(v.begin(), v.end());
+    int key = v[v.size() / 2];
+
+    for (auto _ : state) {
+        auto mid = sls.lower_bound(key);
+        bit::sl_set<int> upper;
+        upper.assign_sorted(mid, sls.end());
+        sls.erase(mid, sls.end());
+        benchmark::DoNotOptimize(upper.size());
+        sls.insert_equal_batch(upper.begin(), upper.end());
+    }
+}
+BENCHMARK(BM_split_join_copy)->Arg(1 << 12)->Arg(1 << 18);
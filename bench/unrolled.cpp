@@ -0,0 +1,71 @@
+#include "bench_util.hpp"
+#include "unrolled_skip_list.hpp"
+
+template <typename T>
+using usl_set = bit::UnrolledSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename SL>
+static void BM_scan(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    for (auto _ : state) {
+        long sum = 0;
+        for (const auto &i : sls) {
+            sum += i;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_scan, bit::sl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_scan, usl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+template <typename SL>
+static void BM_find(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+    SL sls(v.begin(), v.end());
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sls.find(v[i++ % v.size()]));
+    }
+}
+BENCHMARK_TEMPLATE(BM_find, bit::sl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_find, usl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+template <typename SL>
+static void BM_insert(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    for (auto _ : state) {
+        SL sls;
+        for (const auto &i : v) {
+            sls.insert_equal(i);
+        }
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.SetItemsProcessed(state.iterations() * v.size());
+}
+BENCHMARK_TEMPLATE(BM_insert, bit::sl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+BENCHMARK_TEMPLATE(BM_insert, usl_set<int>)->RangeMultiplier(8)->Range(1 << 12, 1 << 18);
+
+template <typename SL>
+static void BM_bytes_per_element(benchmark::State &state) {
+    auto v = bit::get_bench_vector(state.range(0));
+
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        bit::allocated_bytes = 0;
+        SL sls(v.begin(), v.end());
+        bytes = bit::allocated_bytes;
+        benchmark::DoNotOptimize(sls.size());
+    }
+    state.counters["bytes/elem"] = (double)bytes / v.size();
+}
+BENCHMARK_TEMPLATE(BM_bytes_per_element,
+                   bit::SkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+                                 bit::CountingAllocator<int>>)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(BM_bytes_per_element,
+                   bit::UnrolledSkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+                                         256, bit::CountingAllocator<int>>)->Arg(1 << 16);
@@ -0,0 +1,838 @@
+#ifndef _COMPACT_SKIP_LIST_HPP__
+#define _COMPACT_SKIP_LIST_HPP__
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 以 Align 字节为单位编址的连续节点池，句柄即单位下标。空间不足时整体
+ * 搬迁到更大的缓冲区：句柄保持不变，但节点地址随之改变
+ */
+template <std::size_t Align>
+class CompactArena {
+public:
+    using size_type = std::size_t;
+    using handle_type = std::uint32_t;
+
+    constexpr static handle_type NIL = ~handle_type(0);
+    constexpr static size_type MIN_UNITS = 1024;
+    constexpr static size_type MAX_UNITS = size_type(1) << 32;
+public:
+    CompactArena() noexcept : m_base_(nullptr), m_size_(0), m_capacity_(0) {
+    }
+
+    CompactArena(const CompactArena &) = delete;
+    CompactArena &operator=(const CompactArena &) = delete;
+
+    ~CompactArena() {
+        release();
+    }
+
+    inline unsigned char *address(handle_type h) const {
+        return m_base_ + (size_type)h * Align;
+    }
+
+    /*
+     * 需要搬迁时先调用 relocate(old_base, new_base)，此时原内容已按字节
+     * 复制到新缓冲区；relocate 抛出异常时保留原缓冲区
+     */
+    template <typename Relocate>
+    handle_type allocate(size_type units, Relocate relocate) {
+        if (units >= m_free_.size()) {
+            m_free_.resize(units + 1, NIL);
+        }
+        if (m_free_[units] != NIL) {
+            handle_type h = m_free_[units];
+            m_free_[units] = *(handle_type *)address(h);
+            return h;
+        }
+
+        if (m_capacity_ - m_size_ < units) {
+            grow(units, relocate);
+        }
+        handle_type h = (handle_type)m_size_;
+        m_size_ += units;
+        return h;
+    }
+
+    /*
+     * allocate(units) 能否不搬迁节点池就完成
+     */
+    bool fits(size_type units) const {
+        if (units < m_free_.size() && m_free_[units] != NIL) {
+            return true;
+        }
+        return m_capacity_ - m_size_ >= units;
+    }
+
+    void deallocate(handle_type h, size_type units) noexcept {
+        *(handle_type *)address(h) = m_free_[units];
+        m_free_[units] = h;
+    }
+
+    void release() noexcept {
+        free(m_base_);
+        m_base_ = nullptr;
+        m_free_.clear();
+        m_size_ = 0;
+        m_capacity_ = 0;
+    }
+
+    template <typename Relocate>
+    void shrink_to_fit(Relocate relocate) {
+        if (m_base_ && m_size_ < m_capacity_) {
+            reallocate(m_size_, relocate);
+        }
+    }
+
+    bool empty() const {
+        return !m_base_;
+    }
+
+    size_type bytes() const {
+        return m_capacity_ * Align;
+    }
+private:
+    template <typename Relocate>
+    void grow(size_type units, Relocate relocate) {
+        size_type capacity = std::max(MIN_UNITS, m_capacity_ + m_capacity_ / 2);
+        capacity = std::min(std::max(capacity, m_size_ + units), MAX_UNITS);
+        if (capacity - m_size_ < units) {
+            throw std::bad_alloc();
+        }
+        reallocate(capacity, relocate);
+    }
+
+    template <typename Relocate>
+    void reallocate(size_type capacity, Relocate relocate) {
+        unsigned char *base;
+        if constexpr (std::is_same<Relocate, std::nullptr_t>::value) {
+            base = (unsigned char *)realloc(m_base_, capacity * Align);
+            if (!base) {
+                throw std::bad_alloc();
+            }
+        } else {
+            base = (unsigned char *)malloc(capacity * Align);
+            if (!base) {
+                throw std::bad_alloc();
+            }
+            if (m_base_) {
+                memcpy(base, m_base_, m_size_ * Align);
+                try {
+                    relocate(m_base_, base);
+                } catch (...) {
+                    free(base);
+                    throw;
+                }
+                free(m_base_);
+            }
+        }
+        m_base_ = base;
+        m_capacity_ = capacity;
+    }
+private:
+    unsigned char *m_base_;
+    std::vector<handle_type> m_free_;
+    size_type m_size_;
+    size_type m_capacity_;
+};
+
+/*
+ * 节点布局：| 头部 | 第 0 层 prev | value | next[0..fn) |
+ * 头部的低 6 位为层数，最高位标记头节点；链接均为 32 位句柄
+ */
+template <typename T>
+struct CompactSkipListNode {
+public:
+    using size_type = std::size_t;
+    using handle_type = std::uint32_t;
+    using floor_number_type = typename SkipListNodeBase::floor_number_type;
+
+    constexpr static std::uint32_t FLOOR_MASK = 0x3f;
+    constexpr static std::uint32_t HEAD_MASK = std::uint32_t(1) << 31;
+
+    constexpr static size_type ALIGN = std::max(alignof(T), alignof(handle_type));
+    constexpr static size_type VALUE_OFFSET =
+        (2 * sizeof(handle_type) + alignof(T) - 1) / alignof(T) * alignof(T);
+    constexpr static size_type LINK_OFFSET =
+        (VALUE_OFFSET + sizeof(T) + alignof(handle_type) - 1) /
+        alignof(handle_type) * alignof(handle_type);
+public:
+    inline static std::uint32_t &header(unsigned char *p) {
+        return *(std::uint32_t *)p;
+    }
+
+    inline static handle_type &prev(unsigned char *p) {
+        return *(handle_type *)(p + sizeof(std::uint32_t));
+    }
+
+    inline static T *value(unsigned char *p) {
+        return (T *)(p + VALUE_OFFSET);
+    }
+
+    inline static handle_type *floor(unsigned char *p) {
+        return (handle_type *)(p + LINK_OFFSET);
+    }
+
+    inline static size_type units(floor_number_type fn) {
+        return (LINK_OFFSET + fn * sizeof(handle_type) + ALIGN - 1) / ALIGN;
+    }
+};
+
+} // namespace __detail
+
+/*
+ * 紧凑跳表：节点分配在表自有的节点池中，链接是 32 位句柄而不是指针，
+ * 层数与头节点标记压缩在一个 32 位头部中。第 0 层保留反向链接，
+ * 迭代器可以双向移动；删除时通过一次查找得到各层前驱。
+ *
+ * 句柄以 max(alignof(Value), 4) 字节为单位，节点池最多容纳 2^32 个单位。
+ * 插入可能使节点池搬迁，此时迭代器仍然有效，但指向元素的指针与引用失效
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename LevelGenerator = XorshiftLevelGenerator<>>
+class CompactSkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+    using node_type = __detail::CompactSkipListNode<Value>;
+    using arena_type = __detail::CompactArena<node_type::ALIGN>;
+    using handle_type = typename arena_type::handle_type;
+
+    constexpr static handle_type HEAD = 0;
+public:
+    class CompactSkipListIterator {
+    private:
+        friend CompactSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, LevelGenerator>;
+    public:
+        using value_type = Value;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        using self = CompactSkipListIterator;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+    public:
+        CompactSkipListIterator() : m_arena_(nullptr), m_h_(arena_type::NIL) {
+        }
+
+        self &operator++() {
+            m_h_ = node_type::floor(address())[0];
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self &operator--() {
+            m_h_ = node_type::prev(address());
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        reference operator*() const {
+            return *node_type::value(address());
+        }
+
+        pointer operator->() const {
+            return &(this->operator*());
+        }
+
+        explicit operator bool() const {
+            return m_arena_;
+        }
+
+        friend inline bool operator==(const self &a, const self &b) {
+            return a.m_h_ == b.m_h_ && a.m_arena_ == b.m_arena_;
+        }
+
+        friend inline bool operator!=(const self &a, const self &b) {
+            return !operator==(a, b);
+        }
+    private:
+        CompactSkipListIterator(const arena_type *arena, handle_type h) :
+            m_arena_(arena), m_h_(h) {
+        }
+
+        inline unsigned char *address() const {
+            return m_arena_->address(m_h_);
+        }
+    private:
+        const arena_type *m_arena_;
+        handle_type m_h_;
+    };
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
+
+    using level_generator_type = LevelGenerator;
+
+    using self = CompactSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, LevelGenerator>;
+
+    /* 构造参数 p 的默认值，含义与 SkipList::default_probability 相同 */
+    constexpr static double default_probability =
+        __detail::level_probability<LevelGenerator>::value;
+
+    using iterator = CompactSkipListIterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+public:
+    iterator begin() const {
+        return m_arena_->empty() ? end() : make_iterator(link(HEAD, 0));
+    }
+
+    iterator end() const {
+        return make_iterator(HEAD);
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    reference front() {
+        return *begin();
+    }
+
+    const value_type &front() const {
+        return *begin();
+    }
+
+    reference back() {
+        return *(--end());
+    }
+
+    const value_type &back() const {
+        return *(--end());
+    }
+
+    size_type size() const {
+        return m_size_;
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    floor_number_type height() const {
+        return m_fn_;
+    }
+
+    /*
+     * 节点池占用的字节数
+     */
+    size_type arena_bytes() const {
+        return m_arena_->bytes();
+    }
+
+    void shrink_to_fit() {
+        m_arena_->shrink_to_fit(relocator());
+    }
+public:
+    size_type count(const key_type &key) const {
+        size_type c = 0;
+        iterator it = lower_bound(key);
+        while (it != end() && m_c_.less_or_equal(m_kov_(*it), key)) {
+            ++it;
+            ++c;
+        }
+        return c;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key) const {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    iterator find(const key_type &key) const {
+        iterator pos = lower_bound(key);
+        return (pos == end() || m_c_.greater(m_kov_(*pos), key)) ? end() : pos;
+    }
+
+    bool contain(const key_type &key) const {
+        return end() != find(key);
+    }
+
+    void clear() {
+        destory_all();
+    }
+public:
+    explicit CompactSkipList(double p = default_probability) :
+        m_lg_(p), m_size_(0), m_fn_(0), m_arena_(new arena_type()) {
+        static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+        static_assert(alignof(value_type) <= alignof(std::max_align_t),
+                      "over-aligned values are not supported!");
+        static_assert(MaxFloorNumber <= node_type::FLOOR_MASK,
+                      "MaxFloorNumber does not fit in the node header!");
+    }
+
+    template <typename Iterator>
+    explicit CompactSkipList(Iterator first, Iterator last, double p = default_probability) :
+        CompactSkipList(p) {
+        insert_equal(first, last);
+    }
+
+    explicit CompactSkipList(std::initializer_list<value_type> ilist, double p = default_probability) :
+        CompactSkipList(p) {
+        insert_equal(ilist.begin(), ilist.end());
+    }
+
+    CompactSkipList(const self &sl) :
+        m_kov_(sl.m_kov_),
+        m_c_(sl.m_c_),
+        m_lg_(sl.m_lg_),
+        m_size_(0),
+        m_fn_(0),
+        m_arena_(new arena_type()) {
+        append_unsafe(sl.begin(), sl.end());
+    }
+
+    self &operator=(const self &sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = sl.m_kov_;
+            m_c_ = sl.m_c_;
+            m_lg_ = sl.m_lg_;
+
+            append_unsafe(sl.begin(), sl.end());
+        }
+        return *this;
+    }
+
+    CompactSkipList(self &&sl) :
+        m_kov_(std::move(sl.m_kov_)),
+        m_c_(std::move(sl.m_c_)),
+        m_lg_(std::move(sl.m_lg_)),
+        m_size_(sl.m_size_),
+        m_fn_(sl.m_fn_),
+        m_arena_(std::move(sl.m_arena_)) {
+        sl.m_size_ = 0;
+        sl.m_fn_ = 0;
+        sl.m_arena_.reset(new arena_type());
+    }
+
+    self &operator=(self &&sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = std::move(sl.m_kov_);
+            m_c_ = std::move(sl.m_c_);
+            m_lg_ = std::move(sl.m_lg_);
+            m_size_ = sl.m_size_;
+            m_fn_ = sl.m_fn_;
+            std::swap(m_arena_, sl.m_arena_);
+
+            sl.m_size_ = 0;
+            sl.m_fn_ = 0;
+        }
+        return *this;
+    }
+
+    ~CompactSkipList() {
+        clear();
+    }
+
+    iterator lower_bound(const key_type &key) const {
+        return make_iterator(search<false>(key, nullptr));
+    }
+
+    iterator upper_bound(const key_type &key) const {
+        return make_iterator(search<true>(key, nullptr));
+    }
+
+    /*
+     * 以有序区间 [first, last) 替换当前内容，时间复杂度 O(n)
+     */
+    template <typename Iterator>
+    void assign_sorted(Iterator first, Iterator last) {
+        clear();
+        append_unsafe(first, last);
+    }
+
+    iterator insert_equal(const value_type &value) {
+        return emplace_equal(value);
+    }
+
+    iterator insert_equal(value_type &&value) {
+        return emplace_equal(std::move(value));
+    }
+
+    template <typename Iterator>
+    void insert_equal(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_equal(*first++);
+        }
+    }
+
+    void insert_equal(std::initializer_list<value_type> ilist) {
+        insert_equal(ilist.begin(), ilist.end());
+    }
+
+    template <typename ... Args>
+    iterator emplace_equal(Args&& ... args) {
+        handle_type h = create_node(std::forward<Args>(args)...);
+        handle_type path[MaxFloorNumber];
+        path_search(key_of(h), path);
+        return make_iterator(insert_unsafe(path, h));
+    }
+
+    std::pair<iterator, bool> insert_unique(const value_type &value) {
+        return emplace_unique_unsafe(m_kov_(value), value);
+    }
+
+    std::pair<iterator, bool> insert_unique(value_type &&value) {
+        return emplace_unique_unsafe(m_kov_(value), std::move(value));
+    }
+
+    template <typename Iterator>
+    void insert_unique(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_unique(*first++);
+        }
+    }
+
+    void insert_unique(std::initializer_list<value_type> ilist) {
+        insert_unique(ilist.begin(), ilist.end());
+    }
+
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace_unique(Args&& ... args) {
+        handle_type h = create_node(std::forward<Args>(args)...);
+        handle_type path[MaxFloorNumber];
+        handle_type pos = path_search(key_of(h), path);
+        if (pos != HEAD && m_c_.less_or_equal(key_of(pos), key_of(h))) {
+            destory_node(h);
+            return { iterator(), false };
+        }
+        return { make_iterator(insert_unsafe(path, h)), true };
+    }
+
+    iterator erase(iterator pos) {
+        iterator next = pos;
+        ++next;
+        return erase(pos, next);
+    }
+
+    /*
+     * 一次查找得到区间前的各层前驱，再把区间整体摘下
+     */
+    iterator erase(iterator first, iterator last) {
+        if (first == last) {
+            return last;
+        }
+
+        handle_type path[MaxFloorNumber];
+        handle_type tail[MaxFloorNumber];
+        floor_number_type fn = 0;
+        prev_path(first.m_h_, path);
+        for (handle_type h = first.m_h_; h != last.m_h_; h = link(h, 0)) {
+            floor_number_type hfn = floor_number(h);
+            std::fill_n(tail, hfn, h);
+            fn = std::max(fn, hfn);
+        }
+        for (floor_number_type ifn = 0; ifn < fn; ++ifn) {
+            link(path[ifn], ifn) = link(tail[ifn], ifn);
+        }
+        node_type::prev(address(last.m_h_)) = path[0];
+
+        for (handle_type h = first.m_h_; h != last.m_h_;) {
+            handle_type next = link(h, 0);
+            destory_node(h);
+            h = next;
+        }
+
+        while (m_fn_ && link(HEAD, m_fn_ - 1) == HEAD) {
+            --m_fn_;
+        }
+        return last;
+    }
+
+    size_type erase(const key_type &key) {
+        size_type n = 0;
+        iterator first = lower_bound(key);
+        iterator last = first;
+        while (last != end() && m_c_.less_or_equal(m_kov_(*last), key)) {
+            ++last;
+            ++n;
+        }
+        erase(first, last);
+        return n;
+    }
+private:
+    inline iterator make_iterator(handle_type h) const {
+        return iterator(m_arena_.get(), h);
+    }
+
+    inline unsigned char *address(handle_type h) const {
+        return m_arena_->address(h);
+    }
+
+    inline handle_type &link(handle_type h, floor_number_type fn) const {
+        return node_type::floor(address(h))[fn];
+    }
+
+    inline const key_type &key_of(handle_type h) const {
+        return m_kov_(*node_type::value(address(h)));
+    }
+
+    inline floor_number_type floor_number(handle_type h) const {
+        return node_type::header(address(h)) & node_type::FLOOR_MASK;
+    }
+
+    /*
+     * 返回第一个不在 key 之前的节点；path 非空时记录各层上位于其前的
+     * 最后一个节点。下降时同时保存节点地址，每个句柄只解析一次
+     */
+    template <bool Upper>
+    handle_type search(const key_type &key, handle_type *path) const {
+        if (path) {
+            std::fill_n(path + m_fn_, MaxFloorNumber - m_fn_, HEAD);
+        }
+        if (!m_fn_) {
+            return HEAD;
+        }
+
+        floor_number_type fn = m_fn_;
+        handle_type it = HEAD;
+        handle_type next = HEAD;
+        unsigned char *p = address(HEAD);
+        while (fn--) {
+            next = node_type::floor(p)[fn];
+            while (next != HEAD) {
+                unsigned char *np = address(next);
+                const key_type &k = m_kov_(*node_type::value(np));
+                if (Upper ? m_c_.greater(k, key) : !m_c_.less(k, key)) {
+                    break;
+                }
+                it = next;
+                p = np;
+                next = node_type::floor(p)[fn];
+            }
+            if (path) {
+                path[fn] = it;
+            }
+        }
+        return next;
+    }
+
+    handle_type path_search(const key_type &key, handle_type *path) const {
+        return search<false>(key, path);
+    }
+
+    /*
+     * 各层上位于 h 之前的最后一个节点，相等的键沿第 0 层逐个走过
+     */
+    void prev_path(handle_type h, handle_type *path) const {
+        path_search(key_of(h), path);
+        for (handle_type it = link(path[0], 0); it != h; it = link(it, 0)) {
+            std::fill_n(path, floor_number(it), it);
+        }
+    }
+
+    handle_type insert_unsafe(handle_type *path, handle_type h) {
+        floor_number_type hfn = floor_number(h);
+        for (floor_number_type fn = 0; fn < hfn; ++fn) {
+            link(h, fn) = link(path[fn], fn);
+            link(path[fn], fn) = h;
+        }
+        node_type::prev(address(h)) = path[0];
+        node_type::prev(address(link(h, 0))) = h;
+        m_fn_ = std::max(m_fn_, hfn);
+        return h;
+    }
+
+    /*
+     * key 可能引用 value 或表中的元素，只在 create_node() 分配之前读取
+     */
+    template <typename Arg>
+    std::pair<iterator, bool> emplace_unique_unsafe(const key_type &key, Arg &&value) {
+        handle_type path[MaxFloorNumber];
+        handle_type pos = path_search(key, path);
+        if (pos != HEAD && m_c_.less_or_equal(key_of(pos), key)) {
+            return { iterator(), false };
+        }
+        return { make_iterator(insert_unsafe(path, create_node(std::forward<Arg>(value)))),
+                 true };
+    }
+
+    /*
+     * 只用于空表：逐个在尾部追加
+     */
+    template <typename Iterator>
+    void append_unsafe(Iterator first, Iterator last) {
+        handle_type tail[MaxFloorNumber];
+        std::fill_n(tail, MaxFloorNumber, HEAD);
+
+        try {
+            while (first != last) {
+                handle_type h = create_node(*first++);
+                floor_number_type hfn = floor_number(h);
+                node_type::prev(address(h)) = tail[0];
+                for (floor_number_type fn = 0; fn < hfn; ++fn) {
+                    link(h, fn) = HEAD;
+                    link(tail[fn], fn) = h;
+                    tail[fn] = h;
+                }
+                m_fn_ = std::max(m_fn_, hfn);
+            }
+        } catch (...) {
+            close_tail(tail);
+            throw;
+        }
+        close_tail(tail);
+    }
+
+    void close_tail(handle_type *tail) {
+        if (m_arena_->empty()) {
+            return;
+        }
+        for (floor_number_type fn = 0; fn < m_fn_; ++fn) {
+            link(tail[fn], fn) = HEAD;
+        }
+        node_type::prev(address(HEAD)) = tail[0];
+    }
+private:
+    void create_head() {
+        handle_type h = m_arena_->allocate(node_type::units(MaxFloorNumber), relocator());
+        unsigned char *p = address(h);
+        node_type::header(p) = MaxFloorNumber | node_type::HEAD_MASK;
+        node_type::prev(p) = h;
+        std::fill_n(node_type::floor(p), MaxFloorNumber, h);
+    }
+
+    /*
+     * 参数可能引用表中的元素，节点池将要搬迁时先在池外构造出值再移入，
+     * 否则直接在节点中构造
+     */
+    template <typename ... Args>
+    handle_type create_node(Args&& ... args) {
+        if (m_arena_->empty()) {
+            create_head();
+        }
+
+        floor_number_type fn = std::min<floor_number_type>(MaxFloorNumber, m_lg_());
+        if (!m_arena_->fits(node_type::units(fn))) {
+            value_type value(std::forward<Args>(args)...);
+            return construct_node(fn, std::move(value));
+        }
+        return construct_node(fn, std::forward<Args>(args)...);
+    }
+
+    template <typename ... Args>
+    handle_type construct_node(floor_number_type fn, Args&& ... args) {
+        handle_type h = m_arena_->allocate(node_type::units(fn), relocator());
+        unsigned char *p = address(h);
+        try {
+            ::new ((void *)node_type::value(p)) value_type(std::forward<Args>(args)...);
+        } catch (...) {
+            m_arena_->deallocate(h, node_type::units(fn));
+            throw;
+        }
+        node_type::header(p) = (std::uint32_t)fn;
+        ++m_size_;
+        return h;
+    }
+
+    /*
+     * 节点池搬迁时沿第 0 层逐个移动存活节点中的值，
+     * 可平凡复制的值随字节一起搬迁，无需遍历
+     */
+    auto relocator() {
+        if constexpr (std::is_trivially_copyable<value_type>::value) {
+            return nullptr;
+        } else {
+            return [this](unsigned char *from, unsigned char *to) {
+                relocate(from, to);
+            };
+        }
+    }
+
+    void relocate(unsigned char *from, unsigned char *to) {
+        auto at = [](unsigned char *base, handle_type h) {
+            return base + (size_type)h * node_type::ALIGN;
+        };
+        auto next = [&at, to](handle_type h) {
+            return node_type::floor(at(to, h))[0];
+        };
+
+        handle_type h = next(HEAD);
+        try {
+            for (; h != HEAD; h = next(h)) {
+                ::new ((void *)node_type::value(at(to, h))) value_type(
+                    std::move_if_noexcept(*node_type::value(at(from, h))));
+            }
+        } catch (...) {
+            for (handle_type i = next(HEAD); i != h; i = next(i)) {
+                node_type::value(at(to, i))->~value_type();
+            }
+            throw;
+        }
+        for (h = next(HEAD); h != HEAD; h = next(h)) {
+            node_type::value(at(from, h))->~value_type();
+        }
+    }
+
+    void destory_node(handle_type h) {
+        floor_number_type fn = floor_number(h);
+        node_type::value(address(h))->~value_type();
+        m_arena_->deallocate(h, node_type::units(fn));
+        --m_size_;
+    }
+
+    /*
+     * 整个节点池一次归还，头节点在下一次插入时重新创建
+     */
+    void destory_all() {
+        if constexpr (!std::is_trivially_destructible<value_type>::value) {
+            for (handle_type h = m_arena_->empty() ? HEAD : link(HEAD, 0); h != HEAD;
+                 h = link(h, 0)) {
+                node_type::value(address(h))->~value_type();
+            }
+        }
+        m_arena_->release();
+        m_size_ = 0;
+        m_fn_ = 0;
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    level_generator_type m_lg_;
+    size_type m_size_;
+    floor_number_type m_fn_;
+    std::unique_ptr<arena_type> m_arena_;
+};
+
+}
+
+#endif // _COMPACT_SKIP_LIST_HPP__
@@ -0,0 +1,408 @@
+#ifndef _CONCURRENT_SKIP_LIST_HPP__
+#define _CONCURRENT_SKIP_LIST_HPP__
+
+#include <atomic>
+#include <cstdint>
+
+#include "epoch.hpp"
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 并发跳表节点：各层 next 为带标记的指针，最低位置位表示该节点在这一层
+ * 已被逻辑删除。state 记录插入方与删除方谁负责最后的回收
+ */
+template <typename T>
+struct ConcurrentSkipListNode {
+public:
+    using floor_number_type = typename SkipListNodeBase::floor_number_type;
+    using link_type = std::atomic<std::uintptr_t>;
+
+    constexpr static std::uintptr_t MARK = 1;
+
+    constexpr static std::uint8_t LINKING = 1;
+    constexpr static std::uint8_t REMOVED = 2;
+public:
+    const floor_number_type floor_number;
+    std::atomic<std::uint8_t> state;
+    alignas(T) unsigned char storage[sizeof(T)];
+    link_type floor[0];
+public:
+    explicit ConcurrentSkipListNode(floor_number_type fn) :
+        floor_number(fn), state(LINKING) {
+        for (floor_number_type i = 0; i < fn; ++i) {
+            ::new ((void *)&floor[i]) link_type(0);
+        }
+    }
+
+    inline T &value() {
+        return *reinterpret_cast<T *>(storage);
+    }
+
+    inline static ConcurrentSkipListNode *pointer(std::uintptr_t link) {
+        return reinterpret_cast<ConcurrentSkipListNode *>(link & ~MARK);
+    }
+
+    inline static bool marked(std::uintptr_t link) {
+        return link & MARK;
+    }
+
+    inline static std::uintptr_t to_link(ConcurrentSkipListNode *node) {
+        return reinterpret_cast<std::uintptr_t>(node);
+    }
+};
+
+} // namespace __detail
+
+/*
+ * 无锁并发跳表（Fraser / Herlihy 算法），键唯一。
+ *
+ * 插入自底向上用 CAS 逐层链入；删除先自顶向下标记各层 next，
+ * 第 0 层标记成功者即为删除的线性化点，随后的查找顺路摘除被标记的节点。
+ * 查找只读不写，跳过被标记的节点，是无锁的。塔高由 LevelGenerator
+ * 生成，每个线程使用从表的生成器 fork() 出的一个，各线程之间不共享状态。
+ *
+ * 每个操作都在 EpochDomain 的临界区中进行，被摘下的节点在没有线程能访问
+ * 它之后才释放。clear() 与析构不能与其他操作并发
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename LevelGenerator = XorshiftLevelGenerator<>>
+class ConcurrentSkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+    using node_type = __detail::ConcurrentSkipListNode<Value>;
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
+
+    using level_generator_type = LevelGenerator;
+
+    using self = ConcurrentSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, LevelGenerator>;
+
+    /* 构造参数 p 的默认值，含义与 SkipList::default_probability 相同 */
+    constexpr static double default_probability =
+        __detail::level_probability<LevelGenerator>::value;
+public:
+    explicit ConcurrentSkipList(double p = default_probability) :
+        m_lg_(p), m_size_(0), m_fn_(1), m_head_(create_head()) {
+        static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+    }
+
+    ConcurrentSkipList(const self &) = delete;
+    self &operator=(const self &) = delete;
+
+    ~ConcurrentSkipList() {
+        clear();
+        operator delete(m_head_);
+    }
+
+    /*
+     * 并发修改时只是一个近似值
+     */
+    size_type size() const {
+        return m_size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    floor_number_type height() const {
+        return m_fn_.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * 进入表的 epoch 临界区，find() 需要传入这里返回的 Guard
+     */
+    EpochDomain::Guard pin() const {
+        return m_epoch_.pin();
+    }
+public:
+    /*
+     * 无锁查找；guard 须由本表的 pin() 返回，返回的指针在 guard 释放前有效
+     */
+    const value_type *find(const key_type &key, const EpochDomain::Guard & /* guard */) const {
+        node_type *pred = m_head_;
+        node_type *curr = nullptr;
+        floor_number_type fn = m_fn_.load(std::memory_order_acquire);
+        while (fn--) {
+            curr = node_type::pointer(pred->floor[fn].load(std::memory_order_acquire));
+            while (curr) {
+                std::uintptr_t next = curr->floor[fn].load(std::memory_order_acquire);
+                while (node_type::marked(next)) {
+                    curr = node_type::pointer(next);
+                    if (!curr) {
+                        break;
+                    }
+                    next = curr->floor[fn].load(std::memory_order_acquire);
+                }
+                if (!curr || !m_c_.less(key_of(curr), key)) {
+                    break;
+                }
+                pred = curr;
+                curr = node_type::pointer(next);
+            }
+        }
+        if (!curr || m_c_.less(key, key_of(curr)) ||
+            node_type::marked(curr->floor[0].load(std::memory_order_acquire))) {
+            return nullptr;
+        }
+        return &curr->value();
+    }
+
+    bool contain(const key_type &key) const {
+        return find(key, pin());
+    }
+
+    /*
+     * 沿第 0 层按序访问未被删除的元素，只保证弱一致
+     */
+    template <typename F>
+    void for_each(F f) const {
+        EpochDomain::Guard guard = pin();
+        node_type *curr = node_type::pointer(m_head_->floor[0].load(std::memory_order_acquire));
+        while (curr) {
+            std::uintptr_t next = curr->floor[0].load(std::memory_order_acquire);
+            if (!node_type::marked(next)) {
+                f(static_cast<const value_type &>(curr->value()));
+            }
+            curr = node_type::pointer(next);
+        }
+    }
+
+    bool insert_unique(const value_type &value) {
+        return emplace_unique(value);
+    }
+
+    bool insert_unique(value_type &&value) {
+        return emplace_unique(std::move(value));
+    }
+
+    template <typename ... Args>
+    bool emplace_unique(Args&& ... args) {
+        EpochDomain::Guard guard = pin();
+        node_type *node = create_node(std::forward<Args>(args)...);
+        const key_type &key = key_of(node);
+        floor_number_type nfn = node->floor_number;
+        raise_floor_number(nfn);
+
+        node_type *preds[MaxFloorNumber];
+        node_type *succs[MaxFloorNumber];
+        while (true) {
+            if (search(key, preds, succs)) {
+                destory_node(node);
+                return false;
+            }
+            for (floor_number_type fn = 0; fn < nfn; ++fn) {
+                node->floor[fn].store(node_type::to_link(succs[fn]), std::memory_order_relaxed);
+            }
+            std::uintptr_t expected = node_type::to_link(succs[0]);
+            if (preds[0]->floor[0].compare_exchange_strong(expected, node_type::to_link(node),
+                                                           std::memory_order_acq_rel)) {
+                break;
+            }
+        }
+        m_size_.fetch_add(1, std::memory_order_relaxed);
+
+        for (floor_number_type fn = 1; fn < nfn; ++fn) {
+            if (!link_floor(node, fn, preds, succs)) {
+                break;
+            }
+        }
+        /* 链入期间已被删除时，由插入方摘除残留的高层链接 */
+        if (node_type::marked(node->floor[0].load(std::memory_order_acquire))) {
+            search(key, preds, succs);
+        }
+        if (node->state.fetch_and(~node_type::LINKING) & node_type::REMOVED) {
+            retire(node);
+        }
+        return true;
+    }
+
+    bool erase(const key_type &key) {
+        EpochDomain::Guard guard = pin();
+        node_type *preds[MaxFloorNumber];
+        node_type *succs[MaxFloorNumber];
+        if (!search(key, preds, succs)) {
+            return false;
+        }
+
+        node_type *victim = succs[0];
+        for (floor_number_type fn = victim->floor_number; fn-- > 1;) {
+            std::uintptr_t next = victim->floor[fn].load(std::memory_order_acquire);
+            while (!node_type::marked(next) &&
+                   !victim->floor[fn].compare_exchange_weak(next, next | node_type::MARK,
+                                                            std::memory_order_acq_rel)) {
+            }
+        }
+
+        std::uintptr_t next = victim->floor[0].load(std::memory_order_acquire);
+        do {
+            if (node_type::marked(next)) {
+                return false;
+            }
+        } while (!victim->floor[0].compare_exchange_weak(next, next | node_type::MARK,
+                                                         std::memory_order_acq_rel));
+        m_size_.fetch_sub(1, std::memory_order_relaxed);
+
+        search(key, preds, succs);
+        if (!(victim->state.fetch_or(node_type::REMOVED) & node_type::LINKING)) {
+            retire(victim);
+        }
+        return true;
+    }
+
+    /*
+     * 释放已经没有线程能访问的节点，可以与其他操作并发
+     */
+    void reclaim() {
+        m_epoch_.collect();
+    }
+
+    void clear() {
+        m_epoch_.drain();
+        node_type *node = node_type::pointer(m_head_->floor[0].load(std::memory_order_relaxed));
+        while (node) {
+            node_type *next = node_type::pointer(node->floor[0].load(std::memory_order_relaxed));
+            destory_node(node);
+            node = next;
+        }
+        for (floor_number_type fn = 0; fn < MaxFloorNumber; ++fn) {
+            m_head_->floor[fn].store(0, std::memory_order_relaxed);
+        }
+        m_size_.store(0, std::memory_order_relaxed);
+        m_fn_.store(1, std::memory_order_relaxed);
+    }
+private:
+    inline const key_type &key_of(node_type *node) const {
+        return m_kov_(node->value());
+    }
+
+    void raise_floor_number(floor_number_type fn) {
+        floor_number_type top = m_fn_.load(std::memory_order_relaxed);
+        while (top < fn && !m_fn_.compare_exchange_weak(top, fn, std::memory_order_acq_rel)) {
+        }
+    }
+
+    /*
+     * 记录各层上最后一个小于 key 的节点及其后继，途中摘除被标记的节点；
+     * 前驱已被标记导致 CAS 失败时从头重来。返回 key 是否存在
+     */
+    bool search(const key_type &key, node_type **preds, node_type **succs) {
+    retry:
+        node_type *pred = m_head_;
+        for (floor_number_type fn = m_fn_.load(std::memory_order_acquire); fn--;) {
+            node_type *curr = node_type::pointer(pred->floor[fn].load(std::memory_order_acquire));
+            while (curr) {
+                std::uintptr_t next = curr->floor[fn].load(std::memory_order_acquire);
+                while (node_type::marked(next)) {
+                    std::uintptr_t expected = node_type::to_link(curr);
+                    if (!pred->floor[fn].compare_exchange_strong(expected, next & ~node_type::MARK,
+                                                                 std::memory_order_acq_rel)) {
+                        goto retry;
+                    }
+                    curr = node_type::pointer(next);
+                    if (!curr) {
+                        break;
+                    }
+                    next = curr->floor[fn].load(std::memory_order_acquire);
+                }
+                if (!curr || !m_c_.less(key_of(curr), key)) {
+                    break;
+                }
+                pred = curr;
+                curr = node_type::pointer(next);
+            }
+            preds[fn] = pred;
+            succs[fn] = curr;
+        }
+        return succs[0] && !m_c_.less(key, key_of(succs[0]));
+    }
+
+    /*
+     * 把已链入第 0 层的 node 链入第 fn 层；node 已被删除时返回 false
+     */
+    bool link_floor(node_type *node, floor_number_type fn, node_type **preds, node_type **succs) {
+        while (true) {
+            std::uintptr_t next = node->floor[fn].load(std::memory_order_acquire);
+            if (node_type::marked(next)) {
+                return false;
+            }
+            std::uintptr_t succ = node_type::to_link(succs[fn]);
+            if (next != succ &&
+                !node->floor[fn].compare_exchange_strong(next, succ, std::memory_order_acq_rel)) {
+                continue;
+            }
+            if (preds[fn]->floor[fn].compare_exchange_strong(succ, node_type::to_link(node),
+                                                             std::memory_order_acq_rel)) {
+                return true;
+            }
+            search(key_of(node), preds, succs);
+            if (succs[0] != node) {
+                return false;
+            }
+        }
+    }
+
+    void retire(node_type *node) {
+        m_epoch_.retire(node, &self::reclaim_node, nullptr);
+    }
+
+    static void reclaim_node(void *, void *node) {
+        destory_node((node_type *)node);
+    }
+private:
+    floor_number_type random_floor_number() const {
+        return std::min<floor_number_type>(MaxFloorNumber, m_lg_());
+    }
+
+    static node_type *create_head() {
+        void *p = operator new(sizeof(node_type) + MaxFloorNumber * sizeof(typename node_type::link_type));
+        node_type *head = ::new (p) node_type(MaxFloorNumber);
+        head->state.store(0, std::memory_order_relaxed);
+        return head;
+    }
+
+    template <typename ... Args>
+    node_type *create_node(Args&& ... args) const {
+        floor_number_type fn = random_floor_number();
+        void *p = operator new(sizeof(node_type) + fn * sizeof(typename node_type::link_type));
+        node_type *node = ::new (p) node_type(fn);
+        try {
+            ::new ((void *)node->storage) value_type(std::forward<Args>(args)...);
+        } catch (...) {
+            operator delete(p);
+            throw;
+        }
+        return node;
+    }
+
+    static void destory_node(node_type *node) {
+        node->value().~value_type();
+        operator delete(node);
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    mutable __detail::ThreadLevelGenerator<LevelGenerator> m_lg_;
+    std::atomic<size_type> m_size_;
+    std::atomic<floor_number_type> m_fn_;
+    node_type *m_head_;
+    mutable EpochDomain m_epoch_;
+};
+
+}
+
+#endif // _CONCURRENT_SKIP_LIST_HPP__
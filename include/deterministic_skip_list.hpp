@@ -0,0 +1,975 @@
+#ifndef _DETERMINISTIC_SKIP_LIST_HPP__
+#define _DETERMINISTIC_SKIP_LIST_HPP__
+
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 各层共用的链接，up 指向同一元素在上一层的索引节点。
+ * 第 0 层是带头节点的环形双向链表，索引层以 nullptr 结尾
+ */
+struct DeterministicSkipListLink {
+    DeterministicSkipListLink *prev = nullptr;
+    DeterministicSkipListLink *next = nullptr;
+    DeterministicSkipListLink *up = nullptr;
+};
+
+template <typename T>
+struct DeterministicSkipListNode final : public DeterministicSkipListLink {
+public:
+    T value;
+public:
+    template <typename ... Args>
+    explicit DeterministicSkipListNode(Args&& ... args) :
+        value(std::forward<Args>(args)...) {
+    }
+};
+
+/*
+ * 索引节点：down 为同一元素在下一层的节点，node 为其第 0 层的节点
+ */
+struct DeterministicSkipListIndex : public DeterministicSkipListLink {
+    DeterministicSkipListLink *down = nullptr;
+    DeterministicSkipListLink *node = nullptr;
+};
+
+/*
+ * 各层头节点之外的索引节点带有键的副本，查找时不必再访问第 0 层的节点
+ */
+template <typename K>
+struct DeterministicSkipListKeyedIndex final : public DeterministicSkipListIndex {
+public:
+    K key;
+public:
+    explicit DeterministicSkipListKeyedIndex(const K &k) : key(k) {
+    }
+};
+
+template <std::size_t N>
+struct DeterministicSkipListHead {
+    DeterministicSkipListLink base;
+    DeterministicSkipListIndex index[N];
+};
+
+} // namespace __detail
+
+/*
+ * 确定性跳表（1-2-3 skip list）
+ *
+ * 把第 h + 1 层的每个元素与第 0 层头节点看作一组的组首，组内是第 h 层中
+ * 从它开始到下一个组首之前的元素。除顶层外每组有 2 到 4 个元素，顶层
+ * 至多 4 个元素，因此层数不超过 log2(n) + 1，查找每层至多比较 4 次，
+ * 没有随机塔高带来的长尾。
+ *
+ * 插入后组过大时把组内第 3 个元素提升到上一层，删除后组过小时向相邻的
+ * 兄弟组借一个元素（移动组首）或者降下兄弟组的组首与之合并，逐层向上
+ * 传递；调整只沿 up 与 prev 链接进行，不比较键。元素留在第 0 层的节点中，
+ * 提升与降级只分配与释放索引节点，迭代器在插入与删除其他元素时保持有效。
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename Allocator = SkipListPool<Value>>
+class DeterministicSkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+public:
+    class DeterministicSkipListIterator {
+    private:
+        friend DeterministicSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber,
+                                     Allocator>;
+    public:
+        using value_type = Value;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        using link_type = __detail::DeterministicSkipListLink;
+        using self = DeterministicSkipListIterator;
+        using skip_list_node = __detail::DeterministicSkipListNode<value_type>;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+    public:
+        explicit DeterministicSkipListIterator(link_type *p = nullptr) : m_ptr_(p) {
+        }
+
+        self &operator++() {
+            m_ptr_ = m_ptr_->next;
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self &operator--() {
+            m_ptr_ = m_ptr_->prev;
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        reference operator*() const {
+            return ((skip_list_node *)m_ptr_)->value;
+        }
+
+        pointer operator->() const {
+            return &(this->operator*());
+        }
+
+        explicit operator bool() const {
+            return m_ptr_;
+        }
+
+        link_type *base() const {
+            return m_ptr_;
+        }
+
+        friend inline bool operator==(const self &a, const self &b) {
+            return a.m_ptr_ == b.m_ptr_;
+        }
+
+        friend inline bool operator!=(const self &a, const self &b) {
+            return !operator==(a, b);
+        }
+    private:
+        link_type *m_ptr_;
+    };
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
+
+    using link_type = __detail::DeterministicSkipListLink;
+    using index_type = __detail::DeterministicSkipListIndex;
+    using keyed_index_type = __detail::DeterministicSkipListKeyedIndex<key_type>;
+    using skip_list_node = __detail::DeterministicSkipListNode<value_type>;
+    using skip_list_head = __detail::DeterministicSkipListHead<MaxFloorNumber>;
+
+    using allocator_type = Allocator;
+    using node_allocator_type =
+        typename std::allocator_traits<allocator_type>::template rebind_alloc<char>;
+    using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+    using self = DeterministicSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber,
+                                       Allocator>;
+
+    using iterator = DeterministicSkipListIterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    /* 除顶层外每组的元素数在 [MIN_GAP, MAX_GAP] 之间 */
+    constexpr static size_type MIN_GAP = 2;
+    constexpr static size_type MAX_GAP = 4;
+public:
+    iterator begin() const {
+        return iterator(m_head_->base.next);
+    }
+
+    iterator end() const {
+        return iterator(&m_head_->base);
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    reference front() {
+        return *begin();
+    }
+
+    const value_type &front() const {
+        return *begin();
+    }
+
+    reference back() {
+        return *--end();
+    }
+
+    const value_type &back() const {
+        return *--end();
+    }
+
+    size_type size() const {
+        return m_size_;
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    /*
+     * 包括第 0 层在内的层数，空表为 0
+     */
+    floor_number_type height() const {
+        return m_size_ ? m_fn_ + 1 : 0;
+    }
+
+    size_type count(const key_type &key) const {
+        size_type c = 0;
+        iterator it = lower_bound(key);
+        while (it != end() && m_c_.equal(m_kov_(*it), key)) {
+            ++it;
+            ++c;
+        }
+        return c;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key) const {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    /*
+     * 下标为 n 的元素，n 越界时返回 end()；索引层不记录跨度，以下与下标
+     * 有关的操作都沿第 0 层计数
+     */
+    iterator nth(size_type n) const {
+        if (n >= m_size_) {
+            return end();
+        }
+        iterator it = begin();
+        std::advance(it, n);
+        return it;
+    }
+
+    size_type rank(iterator it) const {
+        return std::distance(begin(), it);
+    }
+
+    size_type index_of(const key_type &key) const {
+        return std::distance(begin(), lower_bound(key));
+    }
+
+    difference_type distance(iterator first, iterator last) const {
+        return std::distance(first, last);
+    }
+
+    iterator find(const key_type &key) const {
+        iterator it = lower_bound(key);
+        if (it != end() && m_c_.equal(m_kov_(*it), key)) {
+            return it;
+        }
+        return end();
+    }
+
+    bool contain(const key_type &key) const {
+        return end() != find(key);
+    }
+
+    void clear() {
+        destory_all();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(m_alloc_);
+    }
+public:
+    /*
+     * 结构由元素个数决定，p 只为与 SkipList 的构造函数一致而保留，不起作用
+     */
+    explicit DeterministicSkipList(double = 0.5, const allocator_type &alloc = allocator_type()) :
+        m_size_(0), m_fn_(0), m_alloc_(alloc), m_head_(create_head()) {
+        static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+    }
+
+    template <typename Iterator>
+    explicit DeterministicSkipList(Iterator first, Iterator last, double p = 0.5,
+                                   const allocator_type &alloc = allocator_type()) :
+        DeterministicSkipList(p, alloc) {
+        insert_equal(first, last);
+    }
+
+    explicit DeterministicSkipList(std::initializer_list<value_type> ilist, double p = 0.5,
+                                   const allocator_type &alloc = allocator_type()) :
+        DeterministicSkipList(p, alloc) {
+        insert_equal(ilist);
+    }
+
+    DeterministicSkipList(const self &sl) :
+        m_kov_(sl.m_kov_),
+        m_c_(sl.m_c_),
+        m_size_(0),
+        m_fn_(0),
+        m_alloc_(node_allocator_traits::select_on_container_copy_construction(
+            sl.m_alloc_)),
+        m_head_(create_head()) {
+        append_unsafe(sl.begin(), sl.end());
+    }
+
+    self &operator=(const self &sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = sl.m_kov_;
+            m_c_ = sl.m_c_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_copy_assignment::value) {
+                m_alloc_ = sl.m_alloc_;
+            }
+
+            append_unsafe(sl.begin(), sl.end());
+        }
+        return *this;
+    }
+
+    DeterministicSkipList(self &&sl) :
+        m_kov_(std::move(sl.m_kov_)),
+        m_c_(std::move(sl.m_c_)),
+        m_size_(sl.m_size_),
+        m_fn_(sl.m_fn_),
+        m_alloc_(std::move(sl.m_alloc_)),
+        m_head_(sl.m_head_) {
+        sl.m_size_ = 0;
+        sl.m_fn_ = 0;
+        sl.m_head_ = create_head();
+    }
+
+    self &operator=(self &&sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = std::move(sl.m_kov_);
+            m_c_ = std::move(sl.m_c_);
+            m_size_ = sl.m_size_;
+            m_fn_ = sl.m_fn_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_move_assignment::value) {
+                m_alloc_ = std::move(sl.m_alloc_);
+            }
+            destory_head(m_head_);
+            m_head_ = sl.m_head_;
+
+            sl.m_size_ = 0;
+            sl.m_fn_ = 0;
+            sl.m_head_ = create_head();
+        }
+        return *this;
+    }
+
+    ~DeterministicSkipList() {
+        clear();
+        destory_head(m_head_);
+    }
+
+    iterator lower_bound(const key_type &key) const {
+        return iterator(search<false>(key)->next);
+    }
+
+    iterator upper_bound(const key_type &key) const {
+        return iterator(search<true>(key)->next);
+    }
+
+    /*
+     * hint 恰好是 key 的 lower_bound 时 O(1) 返回，否则从顶层查找
+     */
+    iterator lower_bound(iterator hint, const key_type &key) const {
+        if (hint && fits<true>(hint.base(), key)) {
+            return hint;
+        }
+        return lower_bound(key);
+    }
+
+    /*
+     * 以下批量查找逐个从顶层查找，只为与 SkipList 的接口一致
+     */
+    template <typename KeyIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(KeyIterator first, KeyIterator last,
+                                    OutputIterator out) const {
+        while (first != last) {
+            *out++ = lower_bound(*first++);
+        }
+        return out;
+    }
+
+    template <typename KeyIterator, typename OutputIterator>
+    OutputIterator find_many(KeyIterator first, KeyIterator last,
+                             OutputIterator out) const {
+        while (first != last) {
+            *out++ = find(*first++);
+        }
+        return out;
+    }
+
+    iterator insert_equal(const value_type &value) {
+        return insert_unsafe(search<true>(m_kov_(value)), create_node(value));
+    }
+
+    iterator insert_equal(value_type &&value) {
+        return insert_unsafe(search<true>(m_kov_(value)), create_node(std::move(value)));
+    }
+
+    iterator insert_equal(size_type n, const value_type &value) {
+        iterator ret;
+        while (n--) {
+            ret = insert_equal(value);
+        }
+        return ret;
+    }
+
+    template <typename Iterator>
+    iterator insert_equal(Iterator it) {
+        return insert_equal(*it);
+    }
+
+    template <typename Iterator>
+    void insert_equal(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_equal(*first++);
+        }
+    }
+
+    void insert_equal(std::initializer_list<value_type> ilist) {
+        insert_equal(ilist.begin(), ilist.end());
+    }
+
+    template <typename ... Args>
+    iterator emplace_equal(Args&& ... args) {
+        link_type *node = create_node(std::forward<Args>(args)...);
+        return insert_unsafe(search<true>(key(node)), node);
+    }
+
+    /*
+     * hint 之前的元素不大于新元素且 hint 不小于新元素时直接插在 hint 之前，
+     * 否则忽略 hint，插在相等元素之后
+     */
+    iterator insert_equal(iterator hint, const value_type &value) {
+        return emplace_hint_equal(hint, value);
+    }
+
+    iterator insert_equal(iterator hint, value_type &&value) {
+        return emplace_hint_equal(hint, std::move(value));
+    }
+
+    template <typename ... Args>
+    iterator emplace_hint_equal(iterator hint, Args&& ... args) {
+        link_type *node = create_node(std::forward<Args>(args)...);
+        return insert_unsafe(hint_search<false>(hint, key(node)), node);
+    }
+
+    /*
+     * 已有相等元素时不插入，返回 { iterator(), false }
+     */
+    std::pair<iterator, bool> insert_unique(const value_type &value) {
+        link_type *prev = search<false>(m_kov_(value));
+        if (contain_next(prev, m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, create_node(value)), true };
+    }
+
+    std::pair<iterator, bool> insert_unique(value_type &&value) {
+        link_type *prev = search<false>(m_kov_(value));
+        if (contain_next(prev, m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, create_node(std::move(value))), true };
+    }
+
+    template <typename Iterator>
+    std::pair<iterator, bool> insert_unique(Iterator it) {
+        return insert_unique(*it);
+    }
+
+    template <typename Iterator>
+    void insert_unique(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_unique(*first++);
+        }
+    }
+
+    void insert_unique(std::initializer_list<value_type> ilist) {
+        insert_unique(ilist.begin(), ilist.end());
+    }
+
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace_unique(Args&& ... args) {
+        link_type *node = create_node(std::forward<Args>(args)...);
+        link_type *prev = search<false>(key(node));
+        if (contain_next(prev, key(node))) {
+            destory_node(node);
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, node), true };
+    }
+
+    /*
+     * hint 恰好是新元素的 lower_bound 时省去查找
+     */
+    std::pair<iterator, bool> insert_unique(iterator hint, const value_type &value) {
+        link_type *prev = hint_search<true>(hint, m_kov_(value));
+        if (contain_next(prev, m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, create_node(value)), true };
+    }
+
+    std::pair<iterator, bool> insert_unique(iterator hint, value_type &&value) {
+        link_type *prev = hint_search<true>(hint, m_kov_(value));
+        if (contain_next(prev, m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, create_node(std::move(value))), true };
+    }
+
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace_hint_unique(iterator hint, Args&& ... args) {
+        link_type *node = create_node(std::forward<Args>(args)...);
+        link_type *prev = hint_search<true>(hint, key(node));
+        if (contain_next(prev, key(node))) {
+            destory_node(node);
+            return { iterator(), false };
+        }
+        return { insert_unsafe(prev, node), true };
+    }
+
+    /*
+     * 返回被删除元素之后的元素
+     */
+    iterator erase(iterator it) {
+        iterator next(it.base()->next);
+        extract_unsafe(it.base());
+        destory_node(it.base());
+        return next;
+    }
+
+    iterator erase(iterator first, iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return first;
+    }
+
+    iterator erase(const key_type &key) {
+        return erase(lower_bound(key), upper_bound(key));
+    }
+public:
+    /*
+     * 批量插入：先按键排序，每个元素以前一个插入的元素之后的位置为 hint，
+     * 有序的输入中落在同一处的连续元素不再查找。相等元素插在已有相等元素
+     * 之后，并保持输入中的先后次序
+     */
+    template <typename Iterator>
+    size_type insert_equal_batch(Iterator first, Iterator last) {
+        return insert_batch<false>(first, last);
+    }
+
+    template <typename Iterator>
+    size_type insert_unique_batch(Iterator first, Iterator last) {
+        return insert_batch<true>(first, last);
+    }
+
+    template <typename KeyIterator>
+    size_type erase_batch(KeyIterator first, KeyIterator last) {
+        size_type n = m_size_;
+        while (first != last) {
+            erase(*first++);
+        }
+        return n - m_size_;
+    }
+
+    void unique() {
+        iterator it = begin();
+        while (it != end()) {
+            iterator tmp = it;
+            ++tmp;
+            while (tmp != end() && m_c_.equal(m_kov_(*tmp), m_kov_(*it))) {
+                tmp = erase(tmp);
+            }
+            it = tmp;
+        }
+    }
+
+    /*
+     * [first, last) 必须有序，原有元素全部丢弃
+     */
+    template <typename Iterator>
+    void assign_sorted(Iterator first, Iterator last) {
+        clear();
+        append_unsafe(first, last);
+    }
+private:
+    inline link_type *head(floor_number_type fn) const {
+        return fn ? (link_type *)&m_head_->index[fn - 1] : &m_head_->base;
+    }
+
+    inline const key_type &key(link_type *p) const {
+        return m_kov_(((skip_list_node *)p)->value);
+    }
+
+    /*
+     * 返回第 0 层最后一个键小于 key（Upper 时不大于 key）的节点，
+     * 没有则返回头节点
+     */
+    template <bool Upper>
+    link_type *search(const key_type &k) const {
+        auto before = [&](const key_type &pk) {
+            if constexpr (Upper) {
+                return !m_c_.less(k, pk);
+            } else {
+                return m_c_.less(pk, k);
+            }
+        };
+
+        link_type *p = head(m_fn_);
+        for (floor_number_type fn = m_fn_; fn; --fn) {
+            while (p->next && before(((keyed_index_type *)p->next)->key)) {
+                p = p->next;
+            }
+            p = ((index_type *)p)->down;
+        }
+        while (p->next != &m_head_->base && before(key(p->next))) {
+            p = p->next;
+        }
+        return p;
+    }
+
+    /*
+     * k 能否插在第 0 层的 pos 之前：pos 不小于 k，且它之前的元素不大于 k，
+     * Strict 时还要求小于 k，即 pos 恰好是 k 的 lower_bound
+     */
+    template <bool Strict>
+    bool fits(link_type *pos, const key_type &k) const {
+        link_type *prev = pos->prev;
+        if (prev != &m_head_->base &&
+            (Strict ? !m_c_.less(key(prev), k) : m_c_.less(k, key(prev)))) {
+            return false;
+        }
+        return pos == &m_head_->base || !m_c_.less(key(pos), k);
+    }
+
+    /*
+     * hint 可用时返回它之前的节点，否则与 search<!Strict> 相同
+     */
+    template <bool Strict>
+    link_type *hint_search(iterator hint, const key_type &k) const {
+        if (hint && fits<Strict>(hint.base(), k)) {
+            return hint.base()->prev;
+        }
+        return search<!Strict>(k);
+    }
+
+    inline bool contain_next(link_type *prev, const key_type &k) const {
+        return prev->next != &m_head_->base && m_c_.equal(key(prev->next), k);
+    }
+
+    template <bool Unique, typename Iterator>
+    size_type insert_batch(Iterator first, Iterator last) {
+        std::vector<Iterator> its;
+        for (Iterator it = first; it != last; ++it) {
+            its.push_back(it);
+        }
+        std::stable_sort(its.begin(), its.end(), [this](const Iterator &a, const Iterator &b) {
+            return m_c_.less(m_kov_(*a), m_kov_(*b));
+        });
+
+        size_type n = m_size_;
+        iterator hint = end();
+        for (const auto &it : its) {
+            if (Unique) {
+                auto ret = insert_unique(hint, *it);
+                if (ret.second) {
+                    hint = ++ret.first;
+                }
+            } else {
+                hint = ++insert_equal(hint, *it);
+            }
+        }
+        return m_size_ - n;
+    }
+
+    /*
+     * 第 fn 层（fn < m_fn_）中 p 所在组的组首
+     */
+    inline static link_type *leader(link_type *p) {
+        while (!p->up) {
+            p = p->prev;
+        }
+        return p;
+    }
+
+    /*
+     * 从组首 p 开始的组的元素数，顶层即为整层的元素数
+     */
+    inline size_type gap(link_type *p) const {
+        size_type n = 1;
+        for (p = p->next; p && p != &m_head_->base && !p->up; p = p->next) {
+            ++n;
+        }
+        return n;
+    }
+
+    /*
+     * 把已构造的 node 链入第 0 层的 prev 之后，再逐层调整
+     */
+    iterator insert_unsafe(link_type *prev, link_type *node) {
+        node->prev = prev;
+        node->next = prev->next;
+        prev->next->prev = node;
+        prev->next = node;
+        ++m_size_;
+
+        link_type *p = node;
+
+        /* 组过大时提升组内第 3 个元素，上一层的组随之增大 */
+        for (floor_number_type fn = 0; fn < MaxFloorNumber; ++fn) {
+            if (fn == m_fn_) {
+                if (gap(head(fn)) > MAX_GAP) {
+                    head(fn)->up = head(fn + 1);
+                    ++m_fn_;
+                    promote(head(fn)->next->next, fn);
+                }
+                break;
+            }
+
+            link_type *first = leader(p);
+            if (gap(first) <= MAX_GAP) {
+                break;
+            }
+            p = promote(first->next->next, fn);
+        }
+        return iterator(node);
+    }
+
+    /*
+     * 把 p 从第 0 层摘下，不析构
+     */
+    void extract_unsafe(link_type *p) {
+        link_type *first = nullptr;
+        if (m_fn_) {
+            if (p->up) {
+                /* 索引塔交给同组的下一个元素，组首变为它 */
+                first = p->next;
+                first->up = p->up;
+                ((index_type *)p->up)->down = first;
+                for (link_type *i = p->up; i; i = i->up) {
+                    ((keyed_index_type *)i)->node = first;
+                    ((keyed_index_type *)i)->key = key(first);
+                }
+                p->up = nullptr;
+            } else {
+                first = leader(p);
+            }
+        }
+        p->prev->next = p->next;
+        p->next->prev = p->prev;
+        --m_size_;
+
+        /* 组过小时向兄弟组借一个元素，借不到则与之合并，上一层的组随之减小 */
+        for (floor_number_type fn = 0;; ++fn) {
+            if (fn == m_fn_) {
+                if (fn && !head(fn)->next) {
+                    head(--m_fn_)->up = nullptr;
+                }
+                break;
+            }
+            if (gap(first) >= MIN_GAP) {
+                break;
+            }
+
+            link_type *parent = first->up;
+            link_type *next = parent->next;
+            bool top = fn + 1 == m_fn_;
+            if (next && (top || !next->up)) {
+                link_type *sibling = ((index_type *)next)->down;
+                if (gap(sibling) > MIN_GAP) {
+                    move_leader(next, sibling->next, fn);
+                    break;
+                }
+                demote(next);
+            } else {
+                link_type *prev = parent->prev;
+                if (gap(((index_type *)prev)->down) > MIN_GAP) {
+                    move_leader(parent, first->prev, fn);
+                    break;
+                }
+                demote(parent);
+                parent = prev;
+            }
+            first = top ? nullptr : leader(parent);
+        }
+    }
+
+    /*
+     * 在第 fn + 1 层为第 fn 层的 p 建立索引节点，插在其所在组的组首之后
+     */
+    link_type *promote(link_type *p, floor_number_type fn) {
+        link_type *node = fn ? ((index_type *)p)->node : p;
+        keyed_index_type *i = create_index(key(node));
+        link_type *prev = leader(p)->up;
+        i->down = p;
+        i->node = node;
+        i->prev = prev;
+        i->next = prev->next;
+        if (prev->next) {
+            prev->next->prev = i;
+        }
+        prev->next = i;
+        p->up = i;
+        return i;
+    }
+
+    /*
+     * 删除第 fn + 1 层的索引节点 i，i 之上没有更高的索引
+     */
+    void demote(link_type *i) {
+        i->prev->next = i->next;
+        if (i->next) {
+            i->next->prev = i->prev;
+        }
+        ((index_type *)i)->down->up = nullptr;
+        destory_index((keyed_index_type *)i);
+    }
+
+    /*
+     * 让第 fn + 1 层的索引节点 i 改为指向第 fn 层相邻组之间的元素 p
+     */
+    void move_leader(link_type *i, link_type *p, floor_number_type fn) {
+        link_type *node = fn ? ((index_type *)p)->node : p;
+        ((keyed_index_type *)i)->down->up = nullptr;
+        ((keyed_index_type *)i)->down = p;
+        ((keyed_index_type *)i)->node = node;
+        ((keyed_index_type *)i)->key = key(node);
+        p->up = i;
+    }
+
+    /*
+     * 追加在表尾，只需沿 up 向上调整
+     */
+    template <typename Iterator>
+    void append_unsafe(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_unsafe(m_head_->base.prev, create_node(*first++));
+        }
+    }
+private:
+    skip_list_head *create_head() {
+        skip_list_head *h = new skip_list_head();
+        h->base.prev = h->base.next = &h->base;
+        for (floor_number_type fn = 0; fn < MaxFloorNumber; ++fn) {
+            h->index[fn].down = fn ? (link_type *)&h->index[fn - 1] : &h->base;
+            h->index[fn].node = &h->base;
+        }
+        return h;
+    }
+
+    void destory_head(skip_list_head *h) {
+        delete h;
+    }
+
+    template <typename ... Args>
+    link_type *create_node(Args&& ... args) {
+        skip_list_node *p = (skip_list_node *)node_allocator_traits::allocate(
+            m_alloc_, sizeof(skip_list_node));
+        try {
+            ::new ((void *)p) skip_list_node(std::forward<Args>(args)...);
+        } catch (...) {
+            node_allocator_traits::deallocate(m_alloc_, (char *)p, sizeof(skip_list_node));
+            throw;
+        }
+        return p;
+    }
+
+    void destory_node(link_type *p) {
+        ((skip_list_node *)p)->~skip_list_node();
+        node_allocator_traits::deallocate(m_alloc_, (char *)p, sizeof(skip_list_node));
+    }
+
+    keyed_index_type *create_index(const key_type &k) {
+        keyed_index_type *i = (keyed_index_type *)node_allocator_traits::allocate(
+            m_alloc_, sizeof(keyed_index_type));
+        try {
+            ::new ((void *)i) keyed_index_type(k);
+        } catch (...) {
+            node_allocator_traits::deallocate(m_alloc_, (char *)i, sizeof(keyed_index_type));
+            throw;
+        }
+        return i;
+    }
+
+    void destory_index(keyed_index_type *i) {
+        i->~keyed_index_type();
+        node_allocator_traits::deallocate(m_alloc_, (char *)i, sizeof(keyed_index_type));
+    }
+
+    void destory_all() {
+        constexpr bool release =
+            __detail::has_release<node_allocator_type>::value;
+        constexpr bool trivial =
+            std::is_trivially_destructible<value_type>::value;
+        constexpr bool trivial_key =
+            std::is_trivially_destructible<key_type>::value;
+
+        if constexpr (!(release && trivial)) {
+            link_type *p = m_head_->base.next;
+            while (p != &m_head_->base) {
+                link_type *tmp = p;
+                p = p->next;
+                if constexpr (release) {
+                    ((skip_list_node *)tmp)->~skip_list_node();
+                } else {
+                    destory_node(tmp);
+                }
+            }
+        }
+        if constexpr (!(release && trivial_key)) {
+            for (floor_number_type fn = 1; fn <= m_fn_; ++fn) {
+                link_type *p = head(fn)->next;
+                while (p) {
+                    link_type *tmp = p;
+                    p = p->next;
+                    if constexpr (release) {
+                        ((keyed_index_type *)tmp)->~keyed_index_type();
+                    } else {
+                        destory_index((keyed_index_type *)tmp);
+                    }
+                }
+            }
+        }
+        if constexpr (release) {
+            m_alloc_.release();
+        }
+
+        m_head_->base.prev = m_head_->base.next = &m_head_->base;
+        m_head_->base.up = nullptr;
+        for (floor_number_type fn = 0; fn < m_fn_; ++fn) {
+            m_head_->index[fn].next = nullptr;
+            m_head_->index[fn].up = nullptr;
+        }
+        m_size_ = 0;
+        m_fn_ = 0;
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    size_type m_size_;
+    floor_number_type m_fn_;
+    node_allocator_type m_alloc_;
+    skip_list_head *m_head_;
+};
+
+}
+
+#endif // _DETERMINISTIC_SKIP_LIST_HPP__
@@ -0,0 +1,306 @@
+#ifndef _EPOCH_HPP__
+#define _EPOCH_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace bit {
+
+/*
+ * 基于 epoch 的延迟回收。
+ *
+ * 读者在访问共享节点前调用 pin() 进入临界区，并在此期间宣告自己看到的
+ * 全局 epoch；写者把摘下的节点交给 retire()，节点带上当时的全局 epoch
+ * 进入待回收链表。只有当所有处在临界区中的线程都已看到当前 epoch 时，
+ * 全局 epoch 才能前进；节点在全局 epoch 比它大 2 之后释放，
+ * 此时不再有线程持有它的引用。
+ *
+ * 每个临界区独占一条记录，待回收节点挂在记录上，由之后持有该记录的线程
+ * 在 retire() 或 collect() 中释放，析构时释放全部剩余节点
+ */
+class EpochDomain {
+private:
+    struct Retired {
+        std::uint64_t epoch;
+        void *ptr;
+        void (*deleter)(void *, void *);
+        void *ctx;
+    };
+
+    struct Record {
+        /* 不在临界区时为 0，否则为 (epoch << 1) | 1 */
+        std::atomic<std::uint64_t> epoch{0};
+        std::atomic<bool> owned{false};
+        std::size_t retired = 0;
+        std::vector<Retired> limbo;
+        Record *next = nullptr;
+    };
+
+    /*
+     * 线程最近使用过的记录，id 区分不同的 EpochDomain；
+     * depth 为本线程在该记录上的嵌套层数，为 0 时记录已归还
+     */
+    struct Slot {
+        std::uint64_t id;
+        Record *record;
+        std::size_t depth;
+    };
+
+    constexpr static std::size_t COLLECT_INTERVAL = 64;
+public:
+    class Guard {
+    private:
+        friend EpochDomain;
+    public:
+        Guard() noexcept : m_domain_(nullptr), m_record_(nullptr) {
+        }
+
+        Guard(Guard &&guard) noexcept :
+            m_domain_(guard.m_domain_), m_record_(guard.m_record_) {
+            guard.m_domain_ = nullptr;
+            guard.m_record_ = nullptr;
+        }
+
+        Guard &operator=(Guard &&guard) noexcept {
+            if (this != &guard) {
+                reset();
+                std::swap(m_domain_, guard.m_domain_);
+                std::swap(m_record_, guard.m_record_);
+            }
+            return *this;
+        }
+
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+        ~Guard() {
+            reset();
+        }
+
+        void reset() noexcept {
+            if (m_domain_) {
+                m_domain_->unpin(m_record_);
+                m_domain_ = nullptr;
+                m_record_ = nullptr;
+            }
+        }
+
+        explicit operator bool() const {
+            return m_domain_;
+        }
+    private:
+        Guard(EpochDomain *domain, Record *record) noexcept :
+            m_domain_(domain), m_record_(record) {
+        }
+    private:
+        EpochDomain *m_domain_;
+        Record *m_record_;
+    };
+public:
+    EpochDomain() : m_id_(next_id()), m_epoch_(0), m_records_(nullptr) {
+    }
+
+    EpochDomain(const EpochDomain &) = delete;
+    EpochDomain &operator=(const EpochDomain &) = delete;
+
+    /*
+     * 析构时不能有线程处在临界区中
+     */
+    ~EpochDomain() {
+        drain();
+        Record *record = m_records_.load(std::memory_order_relaxed);
+        while (record) {
+            Record *next = record->next;
+            delete record;
+            record = next;
+        }
+    }
+
+    /*
+     * 进入临界区，可以嵌套
+     */
+    Guard pin() {
+        Slot &slot = current_slot();
+        Record *record = slot.record;
+        if (slot.depth++ == 0) {
+            std::uint64_t epoch = m_epoch_.load(std::memory_order_relaxed);
+            record->epoch.store((epoch << 1) | 1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+        return Guard(this, record);
+    }
+
+    /*
+     * 交出已从共享结构中摘下的对象，在安全时调用 deleter(ctx, ptr)；
+     * deleter 在调用 retire() 或 collect() 的线程上执行
+     */
+    void retire(void *ptr, void (*deleter)(void *, void *), void *ctx) {
+        Guard guard = pin();
+        Record *record = guard.m_record_;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        record->limbo.push_back({ m_epoch_.load(std::memory_order_relaxed), ptr, deleter, ctx });
+        if (++record->retired % COLLECT_INTERVAL == 0) {
+            try_advance();
+            collect(record);
+        }
+    }
+
+    /*
+     * 尝试推进 epoch，并释放空闲记录上已经安全的对象
+     */
+    void collect() {
+        try_advance();
+        for (Record *record = m_records_.load(std::memory_order_acquire); record;
+             record = record->next) {
+            if (acquire(record)) {
+                collect(record);
+                record->owned.store(false, std::memory_order_release);
+            }
+        }
+    }
+
+    /*
+     * 立即释放所有待回收对象，调用者需保证没有线程处在临界区中
+     */
+    void drain() {
+        for (Record *record = m_records_.load(std::memory_order_acquire); record;
+             record = record->next) {
+            for (const auto &r : record->limbo) {
+                r.deleter(r.ctx, r.ptr);
+            }
+            record->limbo.clear();
+        }
+    }
+
+    /*
+     * 尚未释放的对象数，只在没有并发操作时准确
+     */
+    std::size_t pending() const {
+        std::size_t n = 0;
+        for (Record *record = m_records_.load(std::memory_order_acquire); record;
+             record = record->next) {
+            n += record->limbo.size();
+        }
+        return n;
+    }
+
+    std::uint64_t epoch() const {
+        return m_epoch_.load(std::memory_order_relaxed);
+    }
+private:
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> id(0);
+        return ++id;
+    }
+
+    static bool acquire(Record *record) {
+        bool owned = false;
+        return record->owned.compare_exchange_strong(owned, true, std::memory_order_acquire);
+    }
+
+    static std::vector<Slot> &slots() {
+        thread_local std::vector<Slot> s;
+        return s;
+    }
+
+    Slot *find_slot() {
+        for (auto &slot : slots()) {
+            if (slot.id == m_id_) {
+                return &slot;
+            }
+        }
+        return nullptr;
+    }
+
+    /*
+     * 优先复用本线程上次用过的记录；线程在临界区中再次进入时直接沿用
+     */
+    Slot &current_slot() {
+        Slot *slot = find_slot();
+        if (slot) {
+            if (slot->depth == 0 && !acquire(slot->record)) {
+                slot->record = acquire_record();
+            }
+            return *slot;
+        }
+
+        /* 已归还的记录只是提示，可能属于已析构的 EpochDomain */
+        auto &s = slots();
+        s.erase(std::remove_if(s.begin(), s.end(), [](const Slot &slot) {
+            return slot.depth == 0;
+        }), s.end());
+        s.push_back({ m_id_, acquire_record(), 0 });
+        return s.back();
+    }
+
+    Record *acquire_record() {
+        for (Record *record = m_records_.load(std::memory_order_acquire); record;
+             record = record->next) {
+            if (acquire(record)) {
+                return record;
+            }
+        }
+
+        Record *record = new Record();
+        record->owned.store(true, std::memory_order_relaxed);
+        record->next = m_records_.load(std::memory_order_relaxed);
+        while (!m_records_.compare_exchange_weak(record->next, record,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+        }
+        return record;
+    }
+
+    /*
+     * Guard 须在创建它的线程上释放
+     */
+    void unpin(Record *record) noexcept {
+        if (--find_slot()->depth == 0) {
+            record->epoch.store(0, std::memory_order_release);
+            record->owned.store(false, std::memory_order_release);
+        }
+    }
+
+    /*
+     * 所有处在临界区中的线程都已看到当前 epoch 时将其加一
+     */
+    void try_advance() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::uint64_t epoch = m_epoch_.load(std::memory_order_relaxed);
+        for (Record *record = m_records_.load(std::memory_order_acquire); record;
+             record = record->next) {
+            std::uint64_t local = record->epoch.load(std::memory_order_acquire);
+            if ((local & 1) && (local >> 1) != epoch) {
+                return;
+            }
+        }
+        m_epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_release,
+                                         std::memory_order_relaxed);
+    }
+
+    /*
+     * 待回收对象按 epoch 递增排列，释放比当前 epoch 至少小 2 的前缀
+     */
+    void collect(Record *record) {
+        std::uint64_t epoch = m_epoch_.load(std::memory_order_acquire);
+        auto first = record->limbo.begin();
+        auto last = first;
+        while (last != record->limbo.end() && last->epoch + 2 <= epoch) {
+            ++last;
+        }
+        for (auto it = first; it != last; ++it) {
+            it->deleter(it->ctx, it->ptr);
+        }
+        record->limbo.erase(first, last);
+    }
+private:
+    const std::uint64_t m_id_;
+    std::atomic<std::uint64_t> m_epoch_;
+    std::atomic<Record *> m_records_;
+};
+
+}
+
+#endif // _EPOCH_HPP__
@@ -0,0 +1,419 @@
+#ifndef _LAZY_SKIP_LIST_HPP__
+#define _LAZY_SKIP_LIST_HPP__
+
+#include <atomic>
+#include <thread>
+
+#include "epoch.hpp"
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 在 floor_number 之后加入自旋锁与两个标记：marked 表示已被逻辑删除，
+ * fully_linked 表示已链入全部各层。只有写者之间互相加锁
+ */
+struct LazySkipListNodeBase : public SkipListNodeBase {
+public:
+    std::atomic<bool> locked;
+    std::atomic<bool> marked;
+    std::atomic<bool> fully_linked;
+public:
+    explicit LazySkipListNodeBase(floor_number_type fn) :
+        SkipListNodeBase(fn), locked(false), marked(false), fully_linked(false) {
+    }
+
+    void lock() {
+        while (locked.exchange(true, std::memory_order_acquire)) {
+            while (locked.load(std::memory_order_relaxed)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void unlock() {
+        locked.store(false, std::memory_order_release);
+    }
+};
+
+template <typename T>
+struct LazySkipListNode final : public LazySkipListNodeBase {
+public:
+    using floor_type = SkipListNodeFloor<false, false>;
+public:
+    T value;
+    floor_type floor[0];
+public:
+    template <typename ... Args>
+    explicit LazySkipListNode(floor_number_type fn, Args&& ... args) :
+        LazySkipListNodeBase(fn), value(std::forward<Args>(args)...) {
+        std::uninitialized_fill_n(floor, fn, floor_type{ nullptr });
+    }
+};
+
+template <>
+struct LazySkipListNode<void> final : public LazySkipListNodeBase {
+public:
+    using floor_type = SkipListNodeFloor<false, false>;
+public:
+    floor_type floor[0];
+public:
+    explicit LazySkipListNode(floor_number_type fn) :
+        LazySkipListNodeBase(fn | LOAD_MASK) {
+        std::uninitialized_fill_n(floor, fn, floor_type{ nullptr });
+        fully_linked.store(true, std::memory_order_relaxed);
+    }
+};
+
+} // namespace __detail
+
+/*
+ * 基于细粒度锁的并发跳表（lazy synchronization），键唯一。
+ *
+ * 写者先无锁查找各层前驱，再自底向上锁住互不相同的前驱并校验：前驱与
+ * 后继都未被删除且前驱仍指向后继；校验失败则放锁重试。插入在链入全部
+ * 各层后置 fully_linked，删除先锁住并标记目标，再逐层摘除。
+ * 查找不加锁，元素存在当且仅当找到的节点 fully_linked 且未被标记。
+ *
+ * 塔高的生成方式与 ConcurrentSkipList 相同。链接以 release/acquire 读写，
+ * 摘下的节点交给 EpochDomain 延迟回收；
+ * clear() 与析构不能与其他操作并发
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename LevelGenerator = XorshiftLevelGenerator<>>
+class LazySkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+    using base_type = __detail::LazySkipListNodeBase;
+    using node_type = __detail::LazySkipListNode<Value>;
+    using head_type = __detail::LazySkipListNode<void>;
+    using floor_type = typename node_type::floor_type;
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
+
+    using level_generator_type = LevelGenerator;
+
+    using self = LazySkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, LevelGenerator>;
+
+    /* 构造参数 p 的默认值，含义与 SkipList::default_probability 相同 */
+    constexpr static double default_probability =
+        __detail::level_probability<LevelGenerator>::value;
+public:
+    explicit LazySkipList(double p = default_probability) :
+        m_lg_(p), m_size_(0), m_fn_(1), m_head_(create_head()) {
+        static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+    }
+
+    LazySkipList(const self &) = delete;
+    self &operator=(const self &) = delete;
+
+    ~LazySkipList() {
+        clear();
+        m_head_->~head_type();
+        operator delete(m_head_);
+    }
+
+    /*
+     * 并发修改时只是一个近似值
+     */
+    size_type size() const {
+        return m_size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    floor_number_type height() const {
+        return m_fn_.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * 进入表的 epoch 临界区，find() 需要传入这里返回的 Guard
+     */
+    EpochDomain::Guard pin() const {
+        return m_epoch_.pin();
+    }
+public:
+    /*
+     * 不加锁的查找；guard 须由本表的 pin() 返回，返回的指针在 guard 释放前有效
+     */
+    const value_type *find(const key_type &key, const EpochDomain::Guard & /* guard */) const {
+        base_type *preds[MaxFloorNumber];
+        base_type *succs[MaxFloorNumber];
+        floor_number_type fn = search(key, preds, succs);
+        if (fn == MaxFloorNumber) {
+            return nullptr;
+        }
+        node_type *node = to_node(succs[fn]);
+        if (!node->fully_linked.load(std::memory_order_acquire) ||
+            node->marked.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &node->value;
+    }
+
+    bool contain(const key_type &key) const {
+        return find(key, pin());
+    }
+
+    /*
+     * 沿第 0 层按序访问未被删除的元素，只保证弱一致
+     */
+    template <typename F>
+    void for_each(F f) const {
+        EpochDomain::Guard guard = pin();
+        for (base_type *it = load_next(m_head_, 0); it; it = load_next(it, 0)) {
+            if (it->fully_linked.load(std::memory_order_acquire) &&
+                !it->marked.load(std::memory_order_acquire)) {
+                f(static_cast<const value_type &>(to_node(it)->value));
+            }
+        }
+    }
+
+    bool insert_unique(const value_type &value) {
+        return emplace_unique(value);
+    }
+
+    bool insert_unique(value_type &&value) {
+        return emplace_unique(std::move(value));
+    }
+
+    template <typename ... Args>
+    bool emplace_unique(Args&& ... args) {
+        EpochDomain::Guard guard = pin();
+        node_type *node = create_node(std::forward<Args>(args)...);
+        const key_type &key = m_kov_(node->value);
+        floor_number_type nfn = node->getFloorNumber();
+        raise_floor_number(nfn);
+
+        base_type *preds[MaxFloorNumber];
+        base_type *succs[MaxFloorNumber];
+        while (true) {
+            floor_number_type found = search(key, preds, succs);
+            if (found != MaxFloorNumber) {
+                base_type *exist = succs[found];
+                if (!exist->marked.load(std::memory_order_acquire)) {
+                    while (!exist->fully_linked.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    destory_node(node);
+                    return false;
+                }
+                continue;
+            }
+
+            bool locked = lock_preds(preds, nfn, [&](floor_number_type fn) {
+                base_type *succ = succs[fn];
+                return !preds[fn]->marked.load(std::memory_order_acquire) &&
+                       (!succ || !succ->marked.load(std::memory_order_acquire)) &&
+                       load_next(preds[fn], fn) == succ;
+            });
+            if (!locked) {
+                continue;
+            }
+
+            for (floor_number_type fn = 0; fn < nfn; ++fn) {
+                node->floor[fn].next = succs[fn];
+            }
+            for (floor_number_type fn = 0; fn < nfn; ++fn) {
+                store_next(preds[fn], fn, node);
+            }
+            node->fully_linked.store(true, std::memory_order_release);
+            unlock_preds(preds, nfn);
+            m_size_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    bool erase(const key_type &key) {
+        EpochDomain::Guard guard = pin();
+        base_type *preds[MaxFloorNumber];
+        base_type *succs[MaxFloorNumber];
+        base_type *victim = nullptr;
+        floor_number_type vfn = 0;
+        while (true) {
+            floor_number_type found = search(key, preds, succs);
+            if (!victim) {
+                if (found == MaxFloorNumber) {
+                    return false;
+                }
+                /* 只删除在自己的最高层被找到的、完整链入的节点 */
+                base_type *node = succs[found];
+                vfn = node->getFloorNumber();
+                if (!node->fully_linked.load(std::memory_order_acquire) || vfn != found + 1 ||
+                    node->marked.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                node->lock();
+                if (node->marked.load(std::memory_order_relaxed)) {
+                    node->unlock();
+                    return false;
+                }
+                node->marked.store(true, std::memory_order_release);
+                victim = node;
+            }
+
+            bool locked = lock_preds(preds, vfn, [&](floor_number_type fn) {
+                return !preds[fn]->marked.load(std::memory_order_acquire) &&
+                       load_next(preds[fn], fn) == victim;
+            });
+            if (!locked) {
+                continue;
+            }
+
+            for (floor_number_type fn = vfn; fn--;) {
+                store_next(preds[fn], fn, load_next(victim, fn));
+            }
+            victim->unlock();
+            unlock_preds(preds, vfn);
+            m_size_.fetch_sub(1, std::memory_order_relaxed);
+            m_epoch_.retire(victim, &self::reclaim_node, nullptr);
+            return true;
+        }
+    }
+
+    /*
+     * 释放已经没有线程能访问的节点，可以与其他操作并发
+     */
+    void reclaim() {
+        m_epoch_.collect();
+    }
+
+    void clear() {
+        m_epoch_.drain();
+        base_type *it = load_next(m_head_, 0);
+        while (it) {
+            base_type *next = load_next(it, 0);
+            destory_node(to_node(it));
+            it = next;
+        }
+        std::fill_n(m_head_->floor, MaxFloorNumber, floor_type{ nullptr });
+        m_size_.store(0, std::memory_order_relaxed);
+        m_fn_.store(1, std::memory_order_relaxed);
+    }
+private:
+    inline static node_type *to_node(base_type *p) {
+        return static_cast<node_type *>(p);
+    }
+
+    inline static floor_type *floor(base_type *p) {
+        return p->hasLoad() ? to_node(p)->floor : static_cast<head_type *>(p)->floor;
+    }
+
+    inline static base_type *load_next(base_type *p, floor_number_type fn) {
+        return (base_type *)__atomic_load_n(&floor(p)[fn].next, __ATOMIC_ACQUIRE);
+    }
+
+    inline static void store_next(base_type *p, floor_number_type fn, base_type *next) {
+        __atomic_store_n(&floor(p)[fn].next, next, __ATOMIC_RELEASE);
+    }
+
+    void raise_floor_number(floor_number_type fn) {
+        floor_number_type top = m_fn_.load(std::memory_order_relaxed);
+        while (top < fn && !m_fn_.compare_exchange_weak(top, fn, std::memory_order_acq_rel)) {
+        }
+    }
+
+    /*
+     * 记录各层上最后一个小于 key 的节点及其后继，返回 key 所在的最高层，
+     * 不存在时返回 MaxFloorNumber
+     */
+    floor_number_type search(const key_type &key, base_type **preds, base_type **succs) const {
+        floor_number_type found = MaxFloorNumber;
+        base_type *pred = m_head_;
+        for (floor_number_type fn = m_fn_.load(std::memory_order_acquire); fn--;) {
+            base_type *curr = load_next(pred, fn);
+            while (curr && m_c_.less(m_kov_(to_node(curr)->value), key)) {
+                pred = curr;
+                curr = load_next(pred, fn);
+            }
+            if (found == MaxFloorNumber && curr && !m_c_.less(key, m_kov_(to_node(curr)->value))) {
+                found = fn;
+            }
+            preds[fn] = pred;
+            succs[fn] = curr;
+        }
+        return found;
+    }
+
+    /*
+     * 自底向上锁住 preds[0, fn) 中互不相同的节点并逐层校验，
+     * 任一层校验失败时放开已加的锁并返回 false
+     */
+    template <typename Validate>
+    bool lock_preds(base_type **preds, floor_number_type fn, Validate validate) {
+        for (floor_number_type i = 0; i < fn; ++i) {
+            if (i == 0 || preds[i] != preds[i - 1]) {
+                preds[i]->lock();
+            }
+            if (!validate(i)) {
+                unlock_preds(preds, i + 1);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void unlock_preds(base_type **preds, floor_number_type fn) {
+        for (floor_number_type i = 0; i < fn; ++i) {
+            if (i == 0 || preds[i] != preds[i - 1]) {
+                preds[i]->unlock();
+            }
+        }
+    }
+private:
+    floor_number_type random_floor_number() const {
+        return std::min<floor_number_type>(MaxFloorNumber, m_lg_());
+    }
+
+    static head_type *create_head() {
+        void *p = operator new(sizeof(head_type) + MaxFloorNumber * sizeof(floor_type));
+        return ::new (p) head_type(MaxFloorNumber);
+    }
+
+    template <typename ... Args>
+    node_type *create_node(Args&& ... args) const {
+        floor_number_type fn = random_floor_number();
+        void *p = operator new(sizeof(node_type) + fn * sizeof(floor_type));
+        try {
+            return ::new (p) node_type(fn, std::forward<Args>(args)...);
+        } catch (...) {
+            operator delete(p);
+            throw;
+        }
+    }
+
+    static void destory_node(node_type *node) {
+        node->~node_type();
+        operator delete(node);
+    }
+
+    static void reclaim_node(void *, void *node) {
+        destory_node(to_node((base_type *)node));
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    mutable __detail::ThreadLevelGenerator<LevelGenerator> m_lg_;
+    std::atomic<size_type> m_size_;
+    std::atomic<floor_number_type> m_fn_;
+    head_type *m_head_;
+    mutable EpochDomain m_epoch_;
+};
+
+}
+
+#endif // _LAZY_SKIP_LIST_HPP__
@@ -0,0 +1,238 @@
+#ifndef _LEVEL_GENERATOR_HPP__
+#define _LEVEL_GENERATOR_HPP__
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace bit {
+
+/*
+ * 跳表塔高生成器
+ *
+ * 以 LevelGenerator(p) 构造，operator() 返回不小于 1 的塔高，由表截断到
+ * MaxFloorNumber；生成器可以用静态成员 probability 给出默认的增长
+ * 概率，作为表的默认 p；fork() 返回一个与自身独立的生成器，供并行构建的各段
+ * 与 split() 切出的新表使用。生成器随表拷贝与移动。
+ */
+
+namespace __detail {
+
+inline std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9e3779b97f4a7c15ull;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+    return x ^ (x >> 31);
+}
+
+inline unsigned count_leading_zero(std::uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_clzll(x);
+#else
+    unsigned n = 0;
+    while (!(x >> 63)) {
+        x <<= 1;
+        ++n;
+    }
+    return n;
+#endif
+}
+
+/*
+ * 进程内各表默认种子互不相同且每次运行不同
+ */
+inline std::uint64_t level_seed() {
+    static std::atomic<std::uint64_t> s(std::random_device{}());
+    return s.fetch_add(0x9e3779b97f4a7c15ull, std::memory_order_relaxed);
+}
+
+template <typename LevelGenerator, typename = void>
+struct level_probability {
+    constexpr static double value = 0.5;
+};
+
+template <typename LevelGenerator>
+struct level_probability<LevelGenerator, std::void_t<decltype(LevelGenerator::probability)>> {
+    constexpr static double value = LevelGenerator::probability;
+};
+
+}
+
+/*
+ * xorshift64* 生成随机位。p 等于 1/2^Shift 时塔高为开头连续 0 的个数
+ * 除以 Shift 再加 1，每次调用只有几次移位、一次乘法与一条 clz 指令；
+ * xorshift64* 的低位质量最差，因此取高位。其他的 p 逐层比较一个 64 位
+ * 随机数与 p * 2^64，p 不在 [0, 1) 内时抛出 std::invalid_argument。
+ * 种子取自进程内的计数器，不同的表得到不同的序列
+ */
+template <unsigned Shift = 1>
+class XorshiftLevelGenerator {
+    static_assert(Shift > 0 && Shift < 64, "Shift should in [1, 63]!");
+public:
+    constexpr static double probability = 1.0 / (1ull << Shift);
+public:
+    explicit XorshiftLevelGenerator(double p = probability) :
+        m_fixed_(p == probability), m_threshold_(0) {
+        if (!(p >= 0 && p < 1)) {
+            throw std::invalid_argument("XorshiftLevelGenerator: p should in [0, 1)");
+        }
+        if (!m_fixed_) {
+            m_threshold_ = (std::uint64_t)std::ldexp(p, 64);
+        }
+        seed(__detail::level_seed());
+    }
+
+    unsigned operator()() {
+        if (m_fixed_) {
+            /* 最低位置 1 保证 clz 的参数非零，塔高至多为 1 + 63 / Shift */
+            return 1 + __detail::count_leading_zero(next() | 1) / Shift;
+        }
+        unsigned h = 1;
+        while (next() < m_threshold_) {
+            ++h;
+        }
+        return h;
+    }
+
+    void seed(std::uint64_t s) {
+        m_state_ = __detail::splitmix64(s);
+        if (m_state_ == 0) {
+            m_state_ = 0x9e3779b97f4a7c15ull;
+        }
+    }
+
+    XorshiftLevelGenerator fork() {
+        XorshiftLevelGenerator g(*this);
+        g.seed(next());
+        return g;
+    }
+protected:
+    std::uint64_t next() {
+        m_state_ ^= m_state_ >> 12;
+        m_state_ ^= m_state_ << 25;
+        m_state_ ^= m_state_ >> 27;
+        return m_state_ * 0x2545f4914f6cdd1dull;
+    }
+private:
+    bool m_fixed_;
+    std::uint64_t m_threshold_;
+    std::uint64_t m_state_;
+};
+
+/*
+ * 与 XorshiftLevelGenerator 相同，但以固定的 Seed 开始，同样的操作序列
+ * 每次运行得到同样的塔高，用于可复现的基准测试；seed() 可重新播种。
+ * fork() 的种子取自自身的序列，并行构建与 split() 同样可复现
+ */
+template <unsigned Shift = 1, std::uint64_t Seed = 0x5eed>
+class SeededLevelGenerator : public XorshiftLevelGenerator<Shift> {
+public:
+    explicit SeededLevelGenerator(double p = XorshiftLevelGenerator<Shift>::probability) :
+        XorshiftLevelGenerator<Shift>(p) {
+        this->seed(Seed);
+    }
+
+    SeededLevelGenerator fork() {
+        SeededLevelGenerator g(*this);
+        g.seed(this->next());
+        return g;
+    }
+};
+
+/*
+ * std::geometric_distribution 作用于 std::default_random_engine，
+ * 增长概率 p 在运行期由构造参数给出，不要求是 2 的负整数次幂
+ */
+class GeometricLevelGenerator {
+public:
+    explicit GeometricLevelGenerator(double p = 0.5) : m_gd_(1.0 - p) {
+    }
+
+    unsigned operator()() {
+        return m_gd_(m_dre_) + 1;
+    }
+
+    void seed(std::uint64_t s) {
+        m_dre_.seed((std::default_random_engine::result_type)s);
+    }
+
+    GeometricLevelGenerator fork() {
+        GeometricLevelGenerator g(*this);
+        g.seed(m_dre_());
+        return g;
+    }
+private:
+    std::default_random_engine m_dre_;
+    std::geometric_distribution<unsigned> m_gd_;
+};
+
+namespace __detail {
+
+/*
+ * 供并发跳表使用：表持有一个 LevelGenerator，线程第一次在某个表上取塔高
+ * 时加锁从它 fork() 出自己的生成器，之后只访问线程局部的状态。每个线程
+ * 每种生成器最多缓存 SLOTS 个表的生成器，id 区分不同的表
+ */
+template <typename LevelGenerator>
+class ThreadLevelGenerator {
+private:
+    struct Slot {
+        std::uint64_t id;
+        std::optional<LevelGenerator> lg;
+    };
+
+    constexpr static std::size_t SLOTS = 8;
+public:
+    explicit ThreadLevelGenerator(double p) : m_id_(next_id()), m_lg_(p) {
+    }
+
+    ThreadLevelGenerator(const ThreadLevelGenerator &) = delete;
+    ThreadLevelGenerator &operator=(const ThreadLevelGenerator &) = delete;
+
+    unsigned operator()() {
+        return (*current_slot().lg)();
+    }
+private:
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> id(0);
+        return ++id;
+    }
+
+    Slot &current_slot() {
+        thread_local std::vector<Slot> slots;
+        thread_local std::size_t victim = 0;
+        for (auto &slot : slots) {
+            if (slot.id == m_id_) {
+                return slot;
+            }
+        }
+
+        Slot *slot;
+        if (slots.size() < SLOTS) {
+            slot = &slots.emplace_back();
+        } else {
+            slot = &slots[victim++ % SLOTS];
+            slot->id = 0;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex_);
+        slot->lg.emplace(m_lg_.fork());
+        slot->id = m_id_;
+        return *slot;
+    }
+private:
+    const std::uint64_t m_id_;
+    std::mutex m_mutex_;
+    LevelGenerator m_lg_;
+};
+
+}
+
+}
+
+#endif // _LEVEL_GENERATOR_HPP__
@@ -0,0 +1,489 @@
+#ifndef _MVCC_SKIP_LIST_HPP__
+#define _MVCC_SKIP_LIST_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <set>
+
+#include "epoch.hpp"
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 一个键的一个版本，older 指向更旧的版本；value 为空表示该版本删除了这个键
+ */
+template <typename T>
+struct MvccVersion {
+public:
+    const std::uint64_t seq;
+    std::atomic<MvccVersion *> older;
+    const std::optional<T> value;
+public:
+    template <typename ... Args>
+    explicit MvccVersion(std::uint64_t seq, MvccVersion *older, Args&& ... args) :
+        seq(seq), older(older), value(std::forward<Args>(args)...) {
+    }
+
+    /*
+     * 销毁 version 及比它更旧的全部版本，并把内存还给 alloc
+     */
+    template <typename Alloc>
+    static void destory_chain(Alloc &alloc, MvccVersion *version) {
+        while (version) {
+            MvccVersion *older = version->older.load(std::memory_order_relaxed);
+            version->~MvccVersion();
+            alloc.deallocate(version, 1);
+            version = older;
+        }
+    }
+
+    static std::size_t chain_length(MvccVersion *version) {
+        std::size_t n = 0;
+        for (; version; version = version->older.load(std::memory_order_relaxed)) {
+            ++n;
+        }
+        return n;
+    }
+};
+
+/*
+ * 跳表中每个键对应一个条目，head 指向最新的版本；版本链由 MvccSkipList 释放
+ */
+template <typename Key, typename T>
+struct MvccEntry {
+public:
+    const Key key;
+    mutable std::atomic<MvccVersion<T> *> head;
+public:
+    MvccEntry(const Key &key, MvccVersion<T> *head) : key(key), head(head) {
+    }
+};
+
+template <typename Key, typename T>
+struct MvccEntryKey {
+    inline const Key &operator()(const MvccEntry<Key, T> &entry) const {
+        return entry.key;
+    }
+};
+
+} // namespace __detail
+
+/*
+ * 多版本跳表，键唯一。
+ *
+ * 每次修改分配一个递增的序号，并在键的版本链头部加入一个新版本（删除也是
+ * 一个版本）。snapshot() 记下当前序号，快照中的查找与迭代只看到序号不大于
+ * 它的最新版本，因此长时间的范围扫描得到一致的视图，写者无需等待。
+ *
+ * 条目存放在 PublishedLinkPolicy 的 SkipList 中，写者之间用互斥锁串行，
+ * 读者不加锁。任何快照都看不到的旧版本在之后的写入或 gc() 中从版本链上
+ * 截下，在所有快照都已看到时被删除的键整个摘除；二者都经 EpochDomain
+ * 延迟到没有读者能访问之后才释放。版本分配在写者独占的节点池中。
+ *
+ * 快照只在 m_snapshots_ 中登记序号，迭代器停留的条目与版本对该序号可见，
+ * 因而不会被截下或摘除；每次查找与迭代器的移动各自进入两个 EpochDomain
+ * 的临界区，以免经过的节点在此期间被释放。快照与迭代器可以在线程间传递，
+ * 析构 MvccSkipList 时不能有存活的快照
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32>
+class MvccSkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+    using version_type = __detail::MvccVersion<Value>;
+    using entry_type = __detail::MvccEntry<Key, Value>;
+    using list_type = SkipList<Key, entry_type, __detail::MvccEntryKey<Key, Value>, Compare,
+        MaxFloorNumber, SkipListPool<entry_type>, PublishedLinkPolicy>;
+    using list_iterator = typename list_type::iterator;
+
+    constexpr static std::size_t GC_INTERVAL = 64;
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using sequence_type = std::uint64_t;
+
+    using self = MvccSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber>;
+public:
+    class MvccSkipListIterator {
+    private:
+        friend MvccSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber>;
+    public:
+        using value_type = Value;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Value *;
+        using reference = const Value &;
+        using iterator_category = std::forward_iterator_tag;
+
+        using self = MvccSkipListIterator;
+    public:
+        MvccSkipListIterator() : m_sl_(nullptr), m_seq_(0), m_value_(nullptr) {
+        }
+
+        reference operator*() const {
+            return *m_value_;
+        }
+
+        pointer operator->() const {
+            return m_value_;
+        }
+
+        self &operator++() {
+            auto guard = m_sl_->pin();
+            ++m_it_;
+            skip_invisible();
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const self &it) const {
+            return m_it_ == it.m_it_;
+        }
+
+        bool operator!=(const self &it) const {
+            return !operator==(it);
+        }
+    private:
+        /*
+         * 调用者已进入临界区
+         */
+        MvccSkipListIterator(const MvccSkipList *sl, list_iterator it, sequence_type seq) :
+            m_sl_(sl), m_it_(it), m_seq_(seq), m_value_(nullptr) {
+            skip_invisible();
+        }
+
+        void skip_invisible() {
+            while (m_it_ != m_sl_->m_list_.end() && !(m_value_ = visible(*m_it_, m_seq_))) {
+                ++m_it_;
+            }
+        }
+    private:
+        const MvccSkipList *m_sl_;
+        list_iterator m_it_;
+        sequence_type m_seq_;
+        const value_type *m_value_;
+    };
+
+    using iterator = MvccSkipListIterator;
+
+    class Snapshot {
+    private:
+        friend MvccSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber>;
+    public:
+        Snapshot(Snapshot &&snapshot) noexcept :
+            m_sl_(snapshot.m_sl_), m_seq_(snapshot.m_seq_) {
+            snapshot.m_sl_ = nullptr;
+        }
+
+        Snapshot(const Snapshot &) = delete;
+        Snapshot &operator=(const Snapshot &) = delete;
+
+        ~Snapshot() {
+            if (m_sl_) {
+                m_sl_->release_snapshot(m_seq_);
+            }
+        }
+
+        sequence_type sequence() const {
+            return m_seq_;
+        }
+
+        iterator begin() const {
+            auto guard = m_sl_->pin();
+            return iterator(m_sl_, list().begin(), m_seq_);
+        }
+
+        iterator end() const {
+            return iterator(m_sl_, list().end(), m_seq_);
+        }
+
+        iterator lower_bound(const key_type &key) const {
+            auto guard = m_sl_->pin();
+            return iterator(m_sl_, list().lower_bound(key), m_seq_);
+        }
+
+        iterator upper_bound(const key_type &key) const {
+            auto guard = m_sl_->pin();
+            return iterator(m_sl_, list().upper_bound(key), m_seq_);
+        }
+
+        iterator find(const key_type &key) const {
+            auto guard = m_sl_->pin();
+            list_iterator it = list().find(key);
+            if (it == list().end() || !visible(*it, m_seq_)) {
+                return end();
+            }
+            return iterator(m_sl_, it, m_seq_);
+        }
+
+        bool contain(const key_type &key) const {
+            return find(key) != end();
+        }
+    private:
+        explicit Snapshot(const self *sl) : m_sl_(sl) {
+            std::lock_guard<std::mutex> lock(sl->m_snapshot_mutex_);
+            m_seq_ = sl->m_seq_.load(std::memory_order_acquire);
+            sl->m_snapshots_.insert(m_seq_);
+        }
+
+        const list_type &list() const {
+            return m_sl_->m_list_;
+        }
+    private:
+        const self *m_sl_;
+        sequence_type m_seq_;
+    };
+public:
+    explicit MvccSkipList(double p = 0.5) :
+        m_list_(p), m_seq_(0), m_size_(0), m_versions_(0), m_writes_(0) {
+        m_list_.enable_epoch();
+    }
+
+    MvccSkipList(const self &) = delete;
+    self &operator=(const self &) = delete;
+
+    ~MvccSkipList() {
+        for (const auto &entry : m_list_) {
+            version_type::destory_chain(m_version_pool_, entry.head.load(std::memory_order_relaxed));
+        }
+    }
+
+    /*
+     * 最新版本中存在的键数
+     */
+    size_type size() const {
+        return m_size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    /*
+     * 尚未从版本链上截下的版本数，包括删除产生的版本
+     */
+    size_type versions() const {
+        return m_versions_.load(std::memory_order_relaxed);
+    }
+
+    /*
+     * 最近一次修改的序号
+     */
+    sequence_type sequence() const {
+        return m_seq_.load(std::memory_order_acquire);
+    }
+
+    Snapshot snapshot() const {
+        return Snapshot(this);
+    }
+public:
+    /*
+     * 键不存在时插入，否则以 value 作为新版本；返回键此前是否不存在
+     */
+    bool insert_or_assign(const value_type &value) {
+        return put(true, value);
+    }
+
+    bool insert_or_assign(value_type &&value) {
+        return put(true, std::move(value));
+    }
+
+    bool insert_unique(const value_type &value) {
+        return put(false, value);
+    }
+
+    bool insert_unique(value_type &&value) {
+        return put(false, std::move(value));
+    }
+
+    bool erase(const key_type &key) {
+        std::lock_guard<std::mutex> lock(m_write_mutex_);
+        list_iterator it = m_list_.find(key);
+        if (it == m_list_.end() || !alive(*it)) {
+            return false;
+        }
+        commit(it, key, std::nullopt);
+        m_size_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /*
+     * 截下所有快照都看不到的版本，并回收已经没有读者能访问的节点
+     */
+    void gc() {
+        std::lock_guard<std::mutex> lock(m_write_mutex_);
+        gc_unsafe();
+    }
+private:
+    template <typename V>
+    bool put(bool assign, V &&value) {
+        std::lock_guard<std::mutex> lock(m_write_mutex_);
+        key_type key = m_kov_(value);
+        list_iterator it = m_list_.find(key);
+        bool absent = it == m_list_.end() || !alive(*it);
+        if (!absent && !assign) {
+            return false;
+        }
+        commit(it, key, std::forward<V>(value));
+        if (absent) {
+            m_size_.fetch_add(1, std::memory_order_relaxed);
+        }
+        return absent;
+    }
+
+    /*
+     * 在条目 it（不存在时为 end()）的版本链头部加入新版本后发布新的序号
+     */
+    template <typename ... Args>
+    void commit(list_iterator it, const key_type &key, Args&& ... args) {
+        sequence_type seq = m_seq_.load(std::memory_order_relaxed) + 1;
+        version_type *head = it != m_list_.end() ?
+            it->head.load(std::memory_order_relaxed) : nullptr;
+        version_type *version = m_version_pool_.allocate(1);
+        try {
+            ::new ((void *)version) version_type(seq, head, std::forward<Args>(args)...);
+        } catch (...) {
+            m_version_pool_.deallocate(version, 1);
+            throw;
+        }
+
+        if (it != m_list_.end()) {
+            it->head.store(version, std::memory_order_release);
+        } else {
+            try {
+                it = m_list_.emplace_unique(key, version).first;
+            } catch (...) {
+                version_type::destory_chain(m_version_pool_, version);
+                throw;
+            }
+        }
+        m_versions_.fetch_add(1, std::memory_order_relaxed);
+        m_seq_.store(seq, std::memory_order_release);
+
+        collect(it, oldest());
+        if (++m_writes_ >= std::max(GC_INTERVAL, m_list_.size())) {
+            gc_unsafe();
+        }
+    }
+
+    void gc_unsafe() {
+        sequence_type seq = oldest();
+        for (list_iterator it = m_list_.begin(); it != m_list_.end();) {
+            it = collect(it, seq);
+        }
+        m_list_.reclaim();
+        m_version_epoch_.collect();
+        m_writes_ = 0;
+    }
+
+    /*
+     * 序号不小于 seq 的快照都能看到的那个版本之后的版本不再被需要；该版本
+     * 是删除时连同它一起截下，截下的是整条版本链时摘除条目。返回下一个条目
+     */
+    list_iterator collect(list_iterator it, sequence_type seq) {
+        std::atomic<version_type *> *link = &it->head;
+        version_type *version = link->load(std::memory_order_relaxed);
+        while (version && version->seq > seq) {
+            link = &version->older;
+            version = link->load(std::memory_order_relaxed);
+        }
+        if (version && version->value) {
+            link = &version->older;
+            version = link->load(std::memory_order_relaxed);
+        }
+        if (!version) {
+            return ++it;
+        }
+
+        m_versions_.fetch_sub(version_type::chain_length(version), std::memory_order_relaxed);
+        m_version_epoch_.retire(version, &self::reclaim_versions, this);
+        if (link == &it->head) {
+            return m_list_.erase(it);
+        }
+        link->store(nullptr, std::memory_order_release);
+        return ++it;
+    }
+
+    /*
+     * 一次读操作期间同时处在条目与版本两个 EpochDomain 的临界区中
+     */
+    struct ReadGuard {
+        EpochDomain::Guard list;
+        EpochDomain::Guard version;
+    };
+
+    ReadGuard pin() const {
+        return { m_list_.pin(), m_version_epoch_.pin() };
+    }
+
+    static void reclaim_versions(void *sl, void *version) {
+        version_type::destory_chain(((self *)sl)->m_version_pool_, (version_type *)version);
+    }
+
+    /*
+     * 最早的存活快照的序号，没有快照时为当前序号
+     */
+    sequence_type oldest() const {
+        std::lock_guard<std::mutex> lock(m_snapshot_mutex_);
+        if (m_snapshots_.empty()) {
+            return m_seq_.load(std::memory_order_relaxed);
+        }
+        return *m_snapshots_.begin();
+    }
+
+    void release_snapshot(sequence_type seq) const {
+        std::lock_guard<std::mutex> lock(m_snapshot_mutex_);
+        m_snapshots_.erase(m_snapshots_.find(seq));
+    }
+
+    /*
+     * 序号不大于 seq 的最新版本的值，该版本删除了键或不存在时返回 nullptr
+     */
+    static const value_type *visible(const entry_type &entry, sequence_type seq) {
+        for (version_type *version = entry.head.load(std::memory_order_acquire); version;
+             version = version->older.load(std::memory_order_acquire)) {
+            if (version->seq <= seq) {
+                return version->value ? &*version->value : nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool alive(const entry_type &entry) {
+        version_type *head = entry.head.load(std::memory_order_relaxed);
+        return head && head->value;
+    }
+private:
+    key_of_value m_kov_;
+    SkipListPool<version_type> m_version_pool_;
+    mutable EpochDomain m_version_epoch_;
+    list_type m_list_;
+    std::atomic<sequence_type> m_seq_;
+    std::atomic<size_type> m_size_;
+    std::atomic<size_type> m_versions_;
+    size_type m_writes_;
+    std::mutex m_write_mutex_;
+    mutable std::mutex m_snapshot_mutex_;
+    mutable std::multiset<sequence_type> m_snapshots_;
+};
+
+}
+
+#endif // _MVCC_SKIP_LIST_HPP__
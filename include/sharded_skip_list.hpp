@@ -0,0 +1,478 @@
+#ifndef _SHARDED_SKIP_LIST_HPP__
+#define _SHARDED_SKIP_LIST_HPP__
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <vector>
+
+#include "skip_list.hpp"
+
+namespace bit {
+
+/*
+ * 按键区间分片的跳表：第 i 个分片保存 [bounds[i - 1], bounds[i]) 内的元素，
+ * 每个分片是一个独立的 SkipList，带有自己的读写锁、节点池与层数随机数引擎，
+ * 落在不同分片上的写者互不阻塞。
+ *
+ * 读写操作先以共享方式持有分片布局锁，再锁住目标分片；rebalance() 独占
+ * 布局锁后拆分过大或过热的分片、合并过小的相邻分片。scan()/for_each()
+ * 跨分片按序访问，每个分片在访问期间保持一致。
+ *
+ * begin()/end()/lower_bound()/find() 在上述锁下定位，但返回的迭代器不加锁，
+ * 只能在没有写者时使用；rebalance() 会移动元素，使所有迭代器失效
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename Allocator = SkipListPool<Value>>
+class ShardedSkipList {
+public:
+    using list_type = SkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, Allocator>;
+
+    using key_type = Key;
+    using value_type = Value;
+
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    using key_of_value = KeyOfValue;
+    using comparer = typename list_type::comparer;
+
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using self = ShardedSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, Allocator>;
+private:
+    struct Shard {
+    public:
+        mutable std::shared_mutex mutex;
+        list_type list;
+        /* 上次 rebalance() 以来的写入次数，用于判断热点 */
+        size_type writes;
+    public:
+        explicit Shard(double p) : list(p), writes(0) {
+        }
+    };
+
+    using shard_vector = std::vector<std::unique_ptr<Shard>>;
+    using list_iterator = typename list_type::iterator;
+public:
+    class ShardedSkipListIterator {
+    private:
+        friend ShardedSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, Allocator>;
+    public:
+        using value_type = Value;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using self = ShardedSkipListIterator;
+    public:
+        ShardedSkipListIterator() : m_shards_(nullptr), m_index_(0) {
+        }
+
+        self &operator++() {
+            ++m_it_;
+            skip_empty();
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self &operator--() {
+            while (m_index_ == m_shards_->size() || m_it_ == shard().list.begin()) {
+                --m_index_;
+                m_it_ = shard().list.end();
+            }
+            --m_it_;
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        reference operator*() const {
+            return *m_it_;
+        }
+
+        pointer operator->() const {
+            return &*m_it_;
+        }
+
+        bool operator==(const self &other) const {
+            return m_index_ == other.m_index_ && m_it_ == other.m_it_;
+        }
+
+        bool operator!=(const self &other) const {
+            return !(*this == other);
+        }
+    private:
+        ShardedSkipListIterator(const shard_vector *shards, size_type index, list_iterator it) :
+            m_shards_(shards), m_index_(index), m_it_(it) {
+            skip_empty();
+        }
+
+        Shard &shard() const {
+            return *(*m_shards_)[m_index_];
+        }
+
+        /* 停在某个分片的末尾时转到下一个非空分片，全部走完后与 end() 相等 */
+        void skip_empty() {
+            while (m_index_ < m_shards_->size() && m_it_ == shard().list.end()) {
+                if (++m_index_ < m_shards_->size()) {
+                    m_it_ = shard().list.begin();
+                } else {
+                    m_it_ = list_iterator();
+                }
+            }
+        }
+    private:
+        const shard_vector *m_shards_;
+        size_type m_index_;
+        list_iterator m_it_;
+    };
+
+    using iterator = ShardedSkipListIterator;
+public:
+    /*
+     * bounds 为严格递增的分片边界，n 个边界得到 n + 1 个分片
+     */
+    explicit ShardedSkipList(std::vector<key_type> bounds = {}, double p = 0.5) :
+        m_p_(p), m_size_(0), m_max_shard_size_(0), m_bounds_(std::move(bounds)) {
+        for (size_type i = 0; i <= m_bounds_.size(); ++i) {
+            m_shards_.push_back(std::make_unique<Shard>(m_p_));
+        }
+    }
+
+    ShardedSkipList(const self &) = delete;
+    self &operator=(const self &) = delete;
+
+    iterator begin() const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        std::shared_lock<std::shared_mutex> lock(m_shards_.front()->mutex);
+        return iterator(&m_shards_, 0, m_shards_.front()->list.begin());
+    }
+
+    iterator end() const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        return iterator(&m_shards_, m_shards_.size(), list_iterator());
+    }
+
+    /*
+     * 并发修改时只是一个近似值
+     */
+    size_type size() const {
+        return m_size_.load(std::memory_order_relaxed);
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    size_type shard_count() const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        return m_shards_.size();
+    }
+
+    size_type shard_size(size_type i) const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        std::shared_lock<std::shared_mutex> lock(m_shards_[i]->mutex);
+        return m_shards_[i]->list.size();
+    }
+
+    std::vector<key_type> bounds() const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        return m_bounds_;
+    }
+
+    /*
+     * 插入后分片元素数超过 n 时自动拆分，0 表示只在调用 rebalance() 时调整
+     */
+    void set_max_shard_size(size_type n) {
+        std::unique_lock<std::shared_mutex> layout(m_layout_);
+        m_max_shard_size_ = n;
+    }
+
+    size_type max_shard_size() const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        return m_max_shard_size_;
+    }
+public:
+    bool contain(const key_type &key) const {
+        return read(key, [&key](const list_type &list) {
+            return list.contain(key);
+        });
+    }
+
+    size_type count(const key_type &key) const {
+        return read(key, [&key](const list_type &list) {
+            return list.count(key);
+        });
+    }
+
+    /*
+     * 以下查找在与 read() 相同的锁下定位元素，但返回的迭代器不加锁，见类注释
+     */
+    iterator lower_bound(const key_type &key) const {
+        return lookup(key, [&key](const list_type &list) {
+            return list.lower_bound(key);
+        });
+    }
+
+    iterator upper_bound(const key_type &key) const {
+        return lookup(key, [&key](const list_type &list) {
+            return list.upper_bound(key);
+        });
+    }
+
+    iterator find(const key_type &key) const {
+        return lookup(key, [&key](const list_type &list) {
+            return list.find(key);
+        }, true);
+    }
+
+    /*
+     * 按序访问 [first, last) 内的元素，可以与写者并发
+     */
+    template <typename F>
+    void scan(const key_type &first, const key_type &last, F f) const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        for (size_type i = shard_of(first); i < m_shards_.size(); ++i) {
+            if (i > 0 && !m_c_.less(m_bounds_[i - 1], last)) {
+                break;
+            }
+            const Shard &shard = *m_shards_[i];
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (auto it = shard.list.lower_bound(first);
+                 it != shard.list.end() && m_c_.less(m_kov_(*it), last); ++it) {
+                f(static_cast<const value_type &>(*it));
+            }
+        }
+    }
+
+    template <typename F>
+    void for_each(F f) const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        for (const auto &shard : m_shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            for (const auto &i : shard->list) {
+                f(i);
+            }
+        }
+    }
+
+    void insert_equal(const value_type &value) {
+        write(m_kov_(value), [&value](list_type &list) {
+            list.insert_equal(value);
+            return true;
+        });
+    }
+
+    void insert_equal(value_type &&value) {
+        write(m_kov_(value), [&value](list_type &list) {
+            list.insert_equal(std::move(value));
+            return true;
+        });
+    }
+
+    bool insert_unique(const value_type &value) {
+        return write(m_kov_(value), [&value](list_type &list) {
+            return list.insert_unique(value).second;
+        });
+    }
+
+    bool insert_unique(value_type &&value) {
+        return write(m_kov_(value), [&value](list_type &list) {
+            return list.insert_unique(std::move(value)).second;
+        });
+    }
+
+    /*
+     * 删除所有与 key 相等的元素，返回删除的个数
+     */
+    size_type erase(const key_type &key) {
+        size_type n = 0;
+        write(key, [&key, &n](list_type &list) {
+            auto first = list.lower_bound(key);
+            auto last = list.upper_bound(key);
+            n = std::distance(first, last);
+            list.erase(first, last);
+            return n > 0;
+        });
+        return n;
+    }
+
+    void clear() {
+        std::unique_lock<std::shared_mutex> layout(m_layout_);
+        for (auto &shard : m_shards_) {
+            shard->list.clear();
+            shard->writes = 0;
+        }
+        m_size_.store(0, std::memory_order_relaxed);
+    }
+
+    /*
+     * 在中位键处拆分元素数超过 max_shard_size() 的分片，以及写入次数超过
+     * 平均值两倍的热点分片；再合并元素总数不足 max_shard_size() / 4 的
+     * 相邻分片。之后清零各分片的写入计数
+     */
+    void rebalance() {
+        std::unique_lock<std::shared_mutex> layout(m_layout_);
+        size_type writes = 0;
+        for (const auto &shard : m_shards_) {
+            writes += shard->writes;
+        }
+        size_type hot = writes * 2 / m_shards_.size();
+
+        for (size_type i = 0; i < m_shards_.size(); ++i) {
+            Shard &shard = *m_shards_[i];
+            bool large = m_max_shard_size_ && shard.list.size() > m_max_shard_size_;
+            bool busy = hot && shard.writes > hot;
+            if ((large || busy) && split_shard(i)) {
+                /* 热点分片只拆分一次，过大的分片继续检查拆分后的两半 */
+                shard.writes = 0;
+                --i;
+            }
+        }
+
+        if (m_max_shard_size_) {
+            for (size_type i = 0; i + 1 < m_shards_.size();) {
+                size_type n = m_shards_[i]->list.size() + m_shards_[i + 1]->list.size();
+                if (n < m_max_shard_size_ / 4) {
+                    merge_shard(i);
+                } else {
+                    ++i;
+                }
+            }
+        }
+
+        for (auto &shard : m_shards_) {
+            shard->writes = 0;
+        }
+    }
+private:
+    size_type shard_of(const key_type &key) const {
+        return std::upper_bound(m_bounds_.begin(), m_bounds_.end(), key,
+            [this](const key_type &left, const key_type &right) {
+                return m_c_.less(left, right);
+            }) - m_bounds_.begin();
+    }
+
+    template <typename F>
+    auto read(const key_type &key, F f) const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        const Shard &shard = *m_shards_[shard_of(key)];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return f(shard.list);
+    }
+
+    /*
+     * f 在分片内定位；exact 为 true 时未命中返回 end()，否则越过分片末尾继续向后
+     */
+    template <typename F>
+    iterator lookup(const key_type &key, F f, bool exact = false) const {
+        std::shared_lock<std::shared_mutex> layout(m_layout_);
+        size_type i = shard_of(key);
+        const Shard &shard = *m_shards_[i];
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        list_iterator it = f(shard.list);
+        if (exact && it == shard.list.end()) {
+            return iterator(&m_shards_, m_shards_.size(), list_iterator());
+        }
+        return iterator(&m_shards_, i, it);
+    }
+
+    /*
+     * f 返回是否修改了分片；分片超出上限时放开全部锁后再 rebalance()
+     */
+    template <typename F>
+    bool write(const key_type &key, F f) {
+        bool changed;
+        bool oversized;
+        {
+            std::shared_lock<std::shared_mutex> layout(m_layout_);
+            Shard &shard = *m_shards_[shard_of(key)];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            size_type before = shard.list.size();
+            changed = f(shard.list);
+            if (!changed) {
+                return false;
+            }
+            ++shard.writes;
+            size_type after = shard.list.size();
+            if (after > before) {
+                m_size_.fetch_add(after - before, std::memory_order_relaxed);
+            } else {
+                m_size_.fetch_sub(before - after, std::memory_order_relaxed);
+            }
+            oversized = m_max_shard_size_ && after > m_max_shard_size_;
+        }
+        if (oversized) {
+            rebalance();
+        }
+        return true;
+    }
+
+    /*
+     * 把第 i 个分片中键不小于中位键的元素移入新分片；所有元素的键都相等时
+     * 无法拆分，返回 false
+     */
+    bool split_shard(size_type i) {
+        list_type &list = m_shards_[i]->list;
+        if (list.size() < 2) {
+            return false;
+        }
+        list_iterator mid = list.begin();
+        std::advance(mid, list.size() / 2);
+        const key_type &key = m_kov_(*mid);
+        mid = list.lower_bound(key);
+        if (mid == list.begin()) {
+            mid = list.upper_bound(key);
+            if (mid == list.end()) {
+                return false;
+            }
+        }
+
+        key_type bound = m_kov_(*mid);
+        auto upper = std::make_unique<Shard>(m_p_);
+        upper->list = list.split(bound);
+
+        m_bounds_.insert(m_bounds_.begin() + i, std::move(bound));
+        m_shards_.insert(m_shards_.begin() + i + 1, std::move(upper));
+        return true;
+    }
+
+    /*
+     * 把第 i + 1 个分片并入第 i 个分片
+     */
+    void merge_shard(size_type i) {
+        m_shards_[i]->list.join(m_shards_[i + 1]->list);
+        m_bounds_.erase(m_bounds_.begin() + i);
+        m_shards_.erase(m_shards_.begin() + i + 1);
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    const double m_p_;
+    std::atomic<size_type> m_size_;
+    size_type m_max_shard_size_;
+    mutable std::shared_mutex m_layout_;
+    std::vector<key_type> m_bounds_;
+    shard_vector m_shards_;
+};
+
+}
+
+#endif // _SHARDED_SKIP_LIST_HPP__
@@ -1,7 +1,17 @@
 #ifndef _SKIP_LIST_HPP__
 #define _SKIP_LIST_HPP__
 
+#include <algorithm>
+#include <exception>
+#include <memory>
 #include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "epoch.hpp"
+#include "level_generator.hpp"
+#include "skip_list_pool.hpp"
 
 namespace bit {
 
@@ -28,76 +38,218 @@ public:
     }
 };
 
+template <bool Indexed, bool Backward = true>
 struct SkipListNodeFloor {
+    constexpr static bool backward = true;
+
+    SkipListNodeBase *prev;
+    SkipListNodeBase *next;
+};
+
+/*
+ * width 为本层 next 与本节点在第 0 层上的距离
+ */
+template <>
+struct SkipListNodeFloor<true, true> {
+    constexpr static bool backward = true;
+
     SkipListNodeBase *prev;
     SkipListNodeBase *next;
+    std::size_t width;
+};
+
+template <>
+struct SkipListNodeFloor<false, false> {
+    constexpr static bool backward = false;
+
+    SkipListNodeBase *next;
+};
+
+template <typename Floor>
+inline Floor make_floor(SkipListNodeBase *p) {
+    if constexpr (Floor::backward) {
+        if constexpr (std::is_same_v<Floor, SkipListNodeFloor<true, true>>) {
+            return Floor{ p, p, 0 };
+        } else {
+            return Floor{ p, p };
+        }
+    } else {
+        return Floor{ p };
+    }
+}
+
+/*
+ * 只在第 0 层保留反向链接时，prev 存放在节点头部而不是每一层中
+ */
+template <bool BackLink>
+struct SkipListNodeBackLink {
+};
+
+template <>
+struct SkipListNodeBackLink<true> {
+    SkipListNodeBase *prev;
 };
 
-template <typename T>
-struct SkipListNode final : public SkipListNodeBase {
+template <typename T, typename Floor, bool BackLink = false>
+struct SkipListNode final : public SkipListNodeBase, public SkipListNodeBackLink<BackLink> {
 public:
     T value;
-    SkipListNodeFloor floor[0];
+    Floor floor[0];
 public:
     template <typename ... Args>
     explicit SkipListNode(floor_number_type fn, Args&& ... args) :
         SkipListNodeBase(fn),
         value(std::forward<Args>(args)...) {
-        std::uninitialized_fill_n(floor, floor_number,
-                                  SkipListNodeFloor{ this, this });
+        if constexpr (BackLink) {
+            this->prev = this;
+        }
+        std::uninitialized_fill_n(floor, floor_number, make_floor<Floor>(this));
     }
 };
 
-template <>
-struct SkipListNode<void> final : public SkipListNodeBase {
+template <typename Floor, bool BackLink>
+struct SkipListNode<void, Floor, BackLink> final :
+    public SkipListNodeBase, public SkipListNodeBackLink<BackLink> {
 public:
-    SkipListNodeFloor floor[0];
+    Floor floor[0];
 public:
     explicit SkipListNode(floor_number_type fn) :
         SkipListNodeBase(fn | LOAD_MASK) {
-        std::uninitialized_fill_n(floor, getFloorNumber(),
-                                  SkipListNodeFloor{ this, this });
+        if constexpr (BackLink) {
+            this->prev = this;
+        }
+        std::uninitialized_fill_n(floor, getFloorNumber(), make_floor<Floor>(this));
     }
 };
 
-} // namespace __detail
+template <typename Key, typename Compare>
+class SkipListComparer {
+public:
+    inline bool equal(const Key &left, const Key &right) const {
+        return !(m_c_(left, right) || m_c_(right, left));
+    }
 
-template <typename Key, typename Value, typename KeyOfValue, typename Compare,
-    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32>
-class SkipList {
+    inline bool not_equal(const Key &left, const Key &right) const {
+        return !equal(left, right);
+    }
+
+    inline bool less(const Key &left, const Key &right) const {
+        return m_c_(left, right);
+    }
+
+    inline bool greater(const Key &left, const Key &right) const {
+        return m_c_(right, left);
+    }
+
+    inline bool less_or_equal(const Key &left, const Key &right) const {
+        return !greater(left, right);
+    }
+
+    inline bool greater_or_equal(const Key &left, const Key &right) const {
+        return !less(left, right);
+    }
 private:
-    class Comparer {
-    public:
-        inline bool equal(const Key &left, const Key &right) const {
-            return !(m_c_(left, right) || m_c_(right, left));
-        }
+    Compare m_c_;
+};
 
-        inline bool not_equal(const Key &left, const Key &right) const {
-            return !equal(left, right);
-        }
+inline void prefetch(const void *p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#endif
+}
 
-        inline bool less(const Key &left, const Key &right) const {
-            return m_c_(left, right);
-        }
+template <typename Alloc, typename = void>
+struct has_release : std::false_type {
+};
 
-        inline bool greater(const Key &left, const Key &right) const {
-            return m_c_(right, left);
-        }
+template <typename Alloc>
+struct has_release<Alloc, std::void_t<decltype(std::declval<Alloc &>().release())>> :
+    std::true_type {
+};
 
-        inline bool less_or_equal(const Key &left, const Key &right) const {
-            return !greater(left, right);
-        }
+template <typename Alloc, typename = void>
+struct has_absorb : std::false_type {
+};
 
-        inline bool greater_or_equal(const Key &left, const Key &right) const {
-            return !less(left, right);
-        }
-    private:
-        Compare m_c_;
-    };
+template <typename Alloc>
+struct has_absorb<Alloc, std::void_t<decltype(std::declval<Alloc &>().absorb(
+    std::declval<Alloc &>()))>> : std::true_type {
+};
+
+template <typename Alloc, typename = void>
+struct has_share : std::false_type {
+};
+
+template <typename Alloc>
+struct has_share<Alloc, std::void_t<decltype(std::declval<Alloc &>().share(
+    std::declval<const Alloc &>()))>> : std::true_type {
+};
+
+} // namespace __detail
+
+/*
+ * 反向链接的保留范围：all 为每层都有 prev；bottom 只在第 0 层保留，
+ * 迭代器仍可双向移动；none 时迭代器只能前向移动。
+ * 后两者的插入与删除需要一次自顶向下的查找来得到各层前驱
+ */
+enum class LinkBackward {
+    all,
+    bottom,
+    none
+};
+
+struct DefaultLinkPolicy {
+    constexpr static bool indexed = false;
+    constexpr static LinkBackward backward = LinkBackward::all;
+    constexpr static bool published = false;
+};
+
+/*
+ * 每层链接额外记录跨度，支持 O(log n) 的 nth/rank/count/distance
+ */
+struct IndexedLinkPolicy : public DefaultLinkPolicy {
+    constexpr static bool indexed = true;
+};
+
+struct BottomBackwardLinkPolicy : public DefaultLinkPolicy {
+    constexpr static LinkBackward backward = LinkBackward::bottom;
+};
+
+struct ForwardLinkPolicy : public DefaultLinkPolicy {
+    constexpr static LinkBackward backward = LinkBackward::none;
+};
+
+/*
+ * 单写者多读者：插入自底向上以 release 写发布新节点的各层链接，
+ * 读取链接使用 acquire。写者只做插入时，读者无需加锁即可查找与遍历：
+ *
+ * - 读者经任意一层到达的节点，其值与更低各层的链接都已完整可见；
+ * - 遍历是弱一致的：不会看到构造到一半的节点，也不会漏掉遍历开始前
+ *   已经存在的节点，并发插入的节点可能出现也可能不出现；
+ * - 查找至少考虑了在它开始之前（happens-before）完成插入的所有节点。
+ *
+ * 读者只能使用 find/contain/count/lower_bound/upper_bound/equal_range
+ * 与迭代器，且不能开启 finger。开启 epoch 后 erase(iterator) 与
+ * erase(key) 可以与持有 pin() 的读者并发，被摘下的节点保留原来的后继，
+ * 停在其上的读者仍能继续前进（只能前向）；clear 等其他操作仍需与读者互斥
+ */
+struct PublishedLinkPolicy : public DefaultLinkPolicy {
+    constexpr static bool published = true;
+};
+
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    typename Allocator = SkipListPool<Value>,
+    typename LinkPolicy = DefaultLinkPolicy,
+    typename LevelGenerator = XorshiftLevelGenerator<>>
+class SkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
 public:
     class SkipListIterator {
     private:
-        friend SkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber>;
+        friend SkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, Allocator,
+                        LinkPolicy, LevelGenerator>;
     public:
         using value_type = Value;
         using pointer = value_type *;
@@ -105,17 +257,27 @@ public:
 
         using base_type = __detail::SkipListNodeBase *;
         using self = SkipListIterator;
-        using skip_list_head = __detail::SkipListNode<void>;
-        using skip_list_node = __detail::SkipListNode<value_type>;
+        constexpr static bool full_backward = LinkPolicy::backward == LinkBackward::all;
+        constexpr static bool bottom_backward =
+            LinkPolicy::backward == LinkBackward::bottom;
+        constexpr static bool published = LinkPolicy::published;
+
+        using floor_type =
+            __detail::SkipListNodeFloor<LinkPolicy::indexed, full_backward>;
+        using skip_list_head =
+            __detail::SkipListNode<void, floor_type, bottom_backward>;
+        using skip_list_node =
+            __detail::SkipListNode<value_type, floor_type, bottom_backward>;
 
         using difference_type = std::ptrdiff_t;
         using size_type = std::size_t;
 
-        using iterator_category = std::bidirectional_iterator_tag;
+        using iterator_category = std::conditional_t<
+            LinkPolicy::backward == LinkBackward::none,
+            std::forward_iterator_tag, std::bidirectional_iterator_tag>;
 
         using floor_number_type =
             typename __detail::SkipListNodeBase::floor_number_type;
-        using floor_type = __detail::SkipListNodeFloor;
     public:
         explicit SkipListIterator(base_type pBase = nullptr) :
             m_ptr_(pBase) {
@@ -137,24 +299,24 @@ public:
         }
 
         self &operator++() {
-            m_ptr_ = floor()->next;
+            m_ptr_ = get_index_next(0).m_ptr_;
             return *this;
         }
 
         self operator++(int) {
             self tmp = *this;
-            m_ptr_ = floor()->next;
+            m_ptr_ = get_index_next(0).m_ptr_;
             return tmp;
         }
 
         self &operator--() {
-            m_ptr_ = floor()->prev;
+            m_ptr_ = get_index_prev(0).m_ptr_;
             return *this;
         }
 
         self operator--(int) {
             self tmp = *this;
-            m_ptr_ = floor()->prev;
+            m_ptr_ = get_index_prev(0).m_ptr_;
             return tmp;
         }
 
@@ -183,11 +345,23 @@ public:
         }
     private:
         inline void set_next_floor(floor_number_type fn, self it) {
-            floor()[fn].next = it.m_ptr_;
+            store_link(floor()[fn].next, it.m_ptr_);
         }
 
         inline void set_prev_floor(floor_number_type fn, self it) {
-            floor()[fn].prev = it.m_ptr_;
+            if constexpr (full_backward) {
+                store_link(floor()[fn].prev, it.m_ptr_);
+            } else {
+                store_link(back_link()->prev, it.m_ptr_);
+            }
+        }
+
+        inline size_type get_width(floor_number_type fn) const {
+            return floor()[fn].width;
+        }
+
+        inline void set_width(floor_number_type fn, size_type width) {
+            floor()[fn].width = width;
         }
 
         inline floor_number_type floor_number() const {
@@ -199,11 +373,41 @@ public:
         }
 
         inline self get_index_prev(floor_number_type fn) const {
-            return self(floor()[fn].prev);
+            if constexpr (full_backward) {
+                return self(load_link(floor()[fn].prev));
+            } else {
+                return self(load_link(back_link()->prev));
+            }
         }
 
         inline self get_index_next(floor_number_type fn) const {
-            return self(floor()[fn].next);
+            return self(load_link(floor()[fn].next));
+        }
+
+        inline static void store_link(base_type &link, base_type p) {
+            if constexpr (published) {
+                __atomic_store_n(&link, p, __ATOMIC_RELEASE);
+            } else {
+                link = p;
+            }
+        }
+
+        inline static base_type load_link(const base_type &link) {
+            if constexpr (published) {
+                return __atomic_load_n(&link, __ATOMIC_ACQUIRE);
+            } else {
+                return link;
+            }
+        }
+
+        /*
+         * 预取节点头部与第 fn 层链接。floor() 需要读取节点的 floor_number，
+         * 这里改由调用者给出头节点，按节点类型的布局直接算出链接地址
+         */
+        inline void prefetch(floor_number_type fn, self head) const {
+            floor_type *f = m_ptr_ == head.m_ptr_ ? to_head()->floor : to_node()->floor;
+            __detail::prefetch(m_ptr_);
+            __detail::prefetch(f + fn);
         }
 
         inline self get_max_link() const {
@@ -222,6 +426,13 @@ public:
             return (skip_list_head *)m_ptr_;
         }
 
+        inline __detail::SkipListNodeBackLink<bottom_backward> *back_link() const {
+            if (is_head()) {
+                return to_head();
+            }
+            return to_node();
+        }
+
         inline bool is_head() const {
             return !(m_ptr_->hasLoad());
         }
@@ -242,15 +453,41 @@ public:
     using difference_type = std::ptrdiff_t;
 
     using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
-    using floor_type = __detail::SkipListNodeFloor;
+    using floor_type = typename SkipListIterator::floor_type;
+
+    using skip_list_head = typename SkipListIterator::skip_list_head;
+    using skip_list_node = typename SkipListIterator::skip_list_node;
+
+    using link_policy = LinkPolicy;
+    using level_generator_type = LevelGenerator;
 
-    using skip_list_head = __detail::SkipListNode<void>;
-    using skip_list_node = __detail::SkipListNode<value_type>;
+    constexpr static bool full_backward = SkipListIterator::full_backward;
+    constexpr static bool bottom_backward = SkipListIterator::bottom_backward;
+    constexpr static bool published = SkipListIterator::published;
 
-    using self = SkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber>;
+    /* 构造参数 p 的默认值，生成器给出静态成员 probability 时取该值，否则为 0.5 */
+    constexpr static double default_probability =
+        __detail::level_probability<LevelGenerator>::value;
+
+    /* build_parallel() 中每个线程至少处理的元素数 */
+    constexpr static size_type PARALLEL_CHUNK = 1 << 14;
+
+    using allocator_type = Allocator;
+    using node_allocator_type =
+        typename std::allocator_traits<allocator_type>::template rebind_alloc<char>;
+    using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+    using self = SkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber, Allocator,
+                          LinkPolicy, LevelGenerator>;
 
     using iterator = SkipListIterator;
     using reverse_iterator = std::reverse_iterator<iterator>;
+
+    struct FingerStats {
+        size_type searches = 0;
+        size_type reused = 0;
+        size_type skipped_floors = 0;
+    };
 public:
     iterator begin() const {
         iterator tmp = m_it_;
@@ -262,11 +499,11 @@ public:
     }
 
     reverse_iterator rbegin() const {
-        return reverse_iterator(begin);
+        return reverse_iterator(end());
     }
 
     reverse_iterator rend() const {
-        return reverse_iterator(end);
+        return reverse_iterator(begin());
     }
 
     reference front() {
@@ -292,8 +529,88 @@ public:
     bool empty() const {
         return 0 == size();
     }
+
+    floor_number_type height() const {
+        return m_fn_;
+    }
+
+    /*
+     * 塔高生成器，例如 SeededLevelGenerator 可经 seed() 重新播种
+     */
+    level_generator_type &level_generator() {
+        return m_lg_;
+    }
+
+    /*
+     * 开启后 lower_bound/upper_bound/find 等 const 查找会改写 finger 与
+     * finger_stats()，因此不再是只读操作：多个线程即使只做查找（例如都持有
+     * 共享锁）也不能并发调用
+     */
+    void enable_finger(bool enable = true) {
+        if (!enable) {
+            m_finger_.reset();
+        } else if (!m_finger_) {
+            m_finger_.reset(new iterator[MaxFloorNumber]);
+            reset_finger();
+        }
+    }
+
+    bool finger_enabled() const {
+        return (bool)m_finger_;
+    }
+
+    const FingerStats &finger_stats() const {
+        return m_finger_stats_;
+    }
+
+    void reset_finger_stats() {
+        m_finger_stats_ = FingerStats();
+    }
+
+    /*
+     * 开启后 erase 摘下的节点交给 EpochDomain 延迟回收：读者持有 pin()
+     * 返回的 Guard 期间，它可能访问到的节点不会被析构或释放。
+     * 回收在写者线程的 erase 或 reclaim() 中进行，与其他修改操作一样需要串行。
+     * 只有 PublishedLinkPolicy 的链接以原子方式读写，且摘下的节点保留原来的
+     * 后继，其余策略下读者无法与 erase 并发，因此只允许 published 的表开启
+     */
+    template <bool P = published>
+    void enable_epoch(bool enable = true) {
+        static_assert(P, "enable_epoch() needs PublishedLinkPolicy!");
+        if (!enable) {
+            drain_epoch();
+            m_epoch_.reset();
+        } else if (!m_epoch_) {
+            m_epoch_.reset(new EpochDomain());
+        }
+    }
+
+    bool epoch_enabled() const {
+        return (bool)m_epoch_;
+    }
+
+    EpochDomain::Guard pin() const {
+        return m_epoch_ ? m_epoch_->pin() : EpochDomain::Guard();
+    }
+
+    void reclaim() {
+        if (m_epoch_) {
+            m_epoch_->collect();
+        }
+    }
+
+    /*
+     * 已摘下但尚未回收的节点数
+     */
+    size_type retired() const {
+        return m_epoch_ ? m_epoch_->pending() : 0;
+    }
 public:
     size_type count(const key_type &key) const {
+        if constexpr (link_policy::indexed) {
+            return rank_search<true>(key).second - rank_search<false>(key).second;
+        }
+
         size_type c = 0;
         iterator it = lower_bound(key);
         while (it != end() && m_c_.less_or_equal(m_kov_(*it), key)) {
@@ -303,38 +620,126 @@ public:
         return c;
     }
 
+    std::pair<iterator, iterator> equal_range(const key_type &key) const {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    /*
+     * 下标为 n 的元素，n 越界时返回 end()
+     */
+    iterator nth(size_type n) const {
+        if (n >= m_size_) {
+            return end();
+        }
+        if constexpr (!link_policy::indexed) {
+            iterator it = begin();
+            std::advance(it, n);
+            return it;
+        } else {
+            floor_number_type fn = m_fn_;
+            size_type r = 0;
+            iterator it = end();
+            ++n;
+            while (fn--) {
+                iterator next = it.get_index_next(fn);
+                while (next != end() && r + it.get_width(fn) <= n) {
+                    r += it.get_width(fn);
+                    it = next;
+                    next = it.get_index_next(fn);
+                }
+            }
+            return it;
+        }
+    }
+
+    /*
+     * 迭代器所指元素的下标，end() 的下标为 size()
+     */
+    size_type rank(iterator it) const {
+        if constexpr (!link_policy::indexed) {
+            return std::distance(begin(), it);
+        } else {
+            if (it == end()) {
+                return m_size_;
+            }
+            size_type r = 0;
+            while (it != end()) {
+                iterator tmp = it.get_min_link();
+                r += tmp.get_width(it.floor_number() - 1);
+                it = tmp;
+            }
+            return r - 1;
+        }
+    }
+
+    /*
+     * 第一个不小于 key 的元素的下标，即小于 key 的元素个数
+     */
+    size_type index_of(const key_type &key) const {
+        if constexpr (!link_policy::indexed) {
+            return std::distance(begin(), lower_bound(key));
+        } else {
+            return rank_search<false>(key).second;
+        }
+    }
+
+    difference_type distance(iterator first, iterator last) const {
+        if constexpr (!link_policy::indexed) {
+            return std::distance(first, last);
+        } else {
+            return (difference_type)rank(last) - (difference_type)rank(first);
+        }
+    }
+
     bool contain(const key_type &key) const {
         return end() != find(key);
     }
 
     void clear() {
-        erase(begin(), end());
+        destory_all();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(m_alloc_);
     }
 public:
-    explicit SkipList(double p = 0.5) :
-        m_gd_(1.0 - p), m_size_(0), m_it_(create_head()) {
+    explicit SkipList(double p = default_probability, const allocator_type &alloc = allocator_type()) :
+        m_lg_(p), m_size_(0), m_fn_(0), m_alloc_(alloc),
+        m_it_(create_head()) {
         static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+        static_assert(!link_policy::indexed || full_backward,
+                      "IndexedLinkPolicy needs backward links on every floor!");
+        static_assert(!link_policy::indexed || !published,
+                      "widths cannot be published to concurrent readers!");
     }
 
     template <typename Iterator>
-    explicit SkipList(Iterator first, Iterator last, double p = 0.5) :
-        SkipList(p) {
+    explicit SkipList(Iterator first, Iterator last, double p = default_probability,
+                      const allocator_type &alloc = allocator_type()) :
+        SkipList(p, alloc) {
         insert_equal(first, last);
     }
 
-    explicit SkipList(std::initializer_list<value_type> ilist, double p = 0.5) :
-        SkipList(p) {
+    explicit SkipList(std::initializer_list<value_type> ilist, double p = default_probability,
+                      const allocator_type &alloc = allocator_type()) :
+        SkipList(p, alloc) {
         insert_equal(ilist);
     }
 
     SkipList(const self &sl) :
         m_c_(sl.m_c_),
-        m_dre_(sl.m_dre_),
-        m_gd_(sl.m_gd_),
+        m_lg_(sl.m_lg_),
         m_kov_(sl.m_kov_),
         m_size_(0),
+        m_fn_(0),
+        m_alloc_(node_allocator_traits::select_on_container_copy_construction(
+            sl.m_alloc_)),
         m_it_(create_head()) {
-        insert_equal(sl.begin(), sl.end());
+        enable_finger(sl.finger_enabled());
+        if constexpr (published) {
+            enable_epoch(sl.epoch_enabled());
+        }
+        append_unsafe(sl.begin(), sl.end());
     }
 
     self &operator=(const self &sl) {
@@ -342,23 +747,31 @@ public:
             clear();
 
             m_c_ = sl.m_c_;
-            m_dre_ = sl.m_dre_;
-            m_gd_ = sl.m_gd_;
+            m_lg_ = sl.m_lg_;
             m_kov_ = sl.m_kov_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_copy_assignment::value) {
+                m_alloc_ = sl.m_alloc_;
+            }
 
-            insert_equal(sl.begin(), sl.end());
+            append_unsafe(sl.begin(), sl.end());
         }
         return *this;
     }
 
     SkipList(self &&sl) :
+        m_epoch_(sl.release_epoch()),
         m_c_(std::move(sl.m_c_)),
-        m_dre_(std::move(sl.m_dre_)),
-        m_gd_(std::move(sl.m_gd_)),
+        m_lg_(std::move(sl.m_lg_)),
         m_kov_(std::move(sl.m_kov_)),
         m_size_(sl.m_size_),
-        m_it_(std::move(sl.m_it_)) {
+        m_fn_(sl.m_fn_),
+        m_alloc_(std::move(sl.m_alloc_)),
+        m_it_(std::move(sl.m_it_)),
+        m_finger_(std::move(sl.m_finger_)),
+        m_finger_stats_(sl.m_finger_stats_) {
         sl.m_size_ = 0;
+        sl.m_fn_ = 0;
         sl.m_it_ = create_head();
     }
 
@@ -366,14 +779,23 @@ public:
         if (this != &sl) {
             clear();
 
+            m_epoch_ = sl.release_epoch();
             m_c_ = std::move(sl.m_c_);
-            m_dre_ = std::move(sl.m_dre_);
-            m_gd_ = std::move(sl.m_gd_);
+            m_lg_ = std::move(sl.m_lg_);
             m_kov_ = std::move(sl.m_kov_);
             m_size_ = sl.m_size_;
+            m_fn_ = sl.m_fn_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_move_assignment::value) {
+                m_alloc_ = std::move(sl.m_alloc_);
+            }
+            destory_head(m_it_);
             m_it_ = std::move(sl.m_it_);
+            m_finger_ = std::move(sl.m_finger_);
+            m_finger_stats_ = sl.m_finger_stats_;
 
             sl.m_size_ = 0;
+            sl.m_fn_ = 0;
             sl.m_it_ = create_head();
         }
         return *this;
@@ -385,7 +807,11 @@ public:
     }
 
     iterator lower_bound(const key_type &key) const {
-        floor_number_type fn = MaxFloorNumber;
+        if (m_finger_) {
+            return finger_search<false>(key);
+        }
+
+        floor_number_type fn = load_floor_number();
         iterator it = end();
         iterator next = it;
         while (fn--) {
@@ -399,7 +825,11 @@ public:
     }
 
     iterator upper_bound(const key_type &key) const {
-        floor_number_type fn = MaxFloorNumber;
+        if (m_finger_) {
+            return finger_search<true>(key);
+        }
+
+        floor_number_type fn = load_floor_number();
         iterator it = end();
         while (fn--) {
             iterator tmp = it.get_index_next(fn);
@@ -411,11 +841,133 @@ public:
         return ++it;
     }
 
+    /*
+     * 没有逐层的反向链接时，只有位于 key 之前的 hint 能被利用
+     */
+    iterator lower_bound(iterator hint, const key_type &key) const {
+        if (!hint) {
+            return lower_bound(key);
+        }
+
+        floor_number_type fn = 0;
+        iterator it = hint;
+        iterator next = hint;
+        if (hint == end() || m_c_.less_or_equal(key, m_kov_(*hint))) {
+            if constexpr (!full_backward) {
+                return lower_bound(key);
+            } else {
+                it = next.get_index_prev(fn);
+                while (it != end() && m_c_.less_or_equal(key, m_kov_(*it))) {
+                    next = it;
+                    fn = next.floor_number() - 1;
+                    it = next.get_index_prev(fn);
+                }
+            }
+        } else {
+            next = it.get_index_next(fn);
+            while (next != end() && m_c_.less(m_kov_(*next), key)) {
+                it = next;
+                fn = it.floor_number() - 1;
+                next = it.get_index_next(fn);
+            }
+        }
+
+        while (fn--) {
+            next = it.get_index_next(fn);
+            while (next != end() && m_c_.less(m_kov_(*next), key)) {
+                it = next;
+                next = it.get_index_next(fn);
+            }
+        }
+        return next;
+    }
+
+    /*
+     * 对有序的键区间 [first, last) 依次输出 lower_bound，后一次查找从
+     * 前一次的查找路径继续，总代价约为 O(m log(n / m))
+     */
+    template <typename KeyIterator, typename OutputIterator>
+    OutputIterator lower_bound_many(KeyIterator first, KeyIterator last,
+                                    OutputIterator out) const {
+        iterator path[MaxFloorNumber];
+        std::fill_n(path, MaxFloorNumber, end());
+        floor_number_type fn;
+        while (first != last) {
+            *out++ = path_search<false>(*first++, path, fn);
+        }
+        return out;
+    }
+
+    template <typename KeyIterator, typename OutputIterator>
+    OutputIterator find_many(KeyIterator first, KeyIterator last,
+                             OutputIterator out) const {
+        iterator path[MaxFloorNumber];
+        std::fill_n(path, MaxFloorNumber, end());
+        floor_number_type fn;
+        while (first != last) {
+            const key_type &key = *first++;
+            iterator pos = path_search<false>(key, path, fn);
+            *out++ = (pos == end() || m_c_.greater(m_kov_(*pos), key)) ? end() : pos;
+        }
+        return out;
+    }
+
+    /*
+     * 对无序的一批键交错执行多次查找：每组 Group 个查找轮流前进一步，
+     * 并为各自下一步要访问的节点发出预取，使多次缓存缺失得以重叠
+     */
+    template <size_type Group = 16, typename KeyIterator, typename OutputIterator>
+    OutputIterator lower_bound_interleaved(KeyIterator first, KeyIterator last,
+                                           OutputIterator out) const {
+        return interleaved_search<Group, false>(first, last, out);
+    }
+
+    template <size_type Group = 16, typename KeyIterator, typename OutputIterator>
+    OutputIterator find_interleaved(KeyIterator first, KeyIterator last,
+                                    OutputIterator out) const {
+        return interleaved_search<Group, true>(first, last, out);
+    }
+
     iterator find(const key_type &key) const {
         iterator pos = lower_bound(key);
         return (pos == end() || m_c_.greater(m_kov_(*pos), key)) ? end() : pos;
     }
 
+    /*
+     * 以有序区间 [first, last) 替换当前内容，逐个在尾部追加节点，
+     * 不进行任何比较，时间复杂度 O(n)
+     */
+    template <typename Iterator>
+    void assign_sorted(Iterator first, Iterator last) {
+        clear();
+        append_unsafe(first, last);
+    }
+
+    /*
+     * 用 threads 个线程（0 表示硬件线程数）从无序区间构建：分段稳定排序后
+     * 两两归并，再分段生成塔高、构造节点并链接段内各层，最后逐层缝合段间
+     * 边界。只有节点内存的分配是串行的。相等元素保持输入中的先后次序，
+     * 与 insert_equal_batch() 相同
+     */
+    template <typename Iterator>
+    static self build_parallel(Iterator first, Iterator last, size_type threads = 0,
+                               double p = default_probability, const allocator_type &alloc = allocator_type()) {
+        self sl(p, alloc);
+        std::vector<value_type> values(first, last);
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threads = std::max<size_type>(1, std::min(threads, values.size() / PARALLEL_CHUNK));
+
+        std::vector<size_type> bounds(threads + 1);
+        for (size_type i = 0; i <= threads; ++i) {
+            bounds[i] = values.size() * i / threads;
+        }
+        sl.parallel_sort(values, bounds);
+        sl.parallel_append(values, bounds);
+        return sl;
+    }
+
     iterator insert_equal(const value_type &value) {
         return emplace_equal(value);
     }
@@ -453,24 +1005,48 @@ public:
     template <typename ... Args>
     iterator emplace_equal(Args&& ... args) {
         iterator it = create_node(std::forward<Args>(args)...);
-        iterator pos = lower_bound(m_kov_(*it));
-        return insert_unsafe(pos, it);
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(iterator(), m_kov_(*it), path);
+        return insert_unsafe(pos, it, path);
+    }
+
+    /*
+     * 带 hint 的插入只在每层都有反向链接时利用 hint；BottomBackward 与
+     * Forward 策略需要各层前驱，会忽略 hint 做一次完整查找（开启 finger
+     * 时从 finger 出发），insert_unique 与 emplace_hint_* 同理
+     */
+    iterator insert_equal(iterator hint, const value_type &value) {
+        return emplace_hint_equal(hint, value);
+    }
+
+    iterator insert_equal(iterator hint, value_type &&value) {
+        return emplace_hint_equal(hint, std::move(value));
+    }
+
+    template <typename ... Args>
+    iterator emplace_hint_equal(iterator hint, Args&& ... args) {
+        iterator it = create_node(std::forward<Args>(args)...);
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(hint, m_kov_(*it), path);
+        return insert_unsafe(pos, it, path);
     }
 
     std::pair<iterator, bool> insert_unique(const value_type &value) {
-        iterator pos = lower_bound(m_kov_(value));
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(iterator(), m_kov_(value), path);
         if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(value))) {
             return { iterator(), false };
         }
-        return { insert_unsafe(pos, create_node(value)), true };
+        return { insert_unsafe(pos, create_node(value), path), true };
     }
 
     std::pair<iterator, bool> insert_unique(value_type &&value) {
-        iterator pos = lower_bound(m_kov_(value));
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(iterator(), m_kov_(value), path);
         if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(value))) {
             return { iterator(), false };
         }
-        return { insert_unsafe(pos, create_node(std::move(value))), true };
+        return { insert_unsafe(pos, create_node(std::move(value)), path), true };
     }
 
     template <typename Iterator>
@@ -494,34 +1070,100 @@ public:
     template <typename ... Args>
     std::pair<iterator, bool> emplace_unique(Args&& ... args) {
         iterator it = create_node(std::forward<Args>(args)...);
-        iterator pos = lower_bound(m_kov_(*it));
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(iterator(), m_kov_(*it), path);
+        if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(*it))) {
+            destory_node(it);
+            return { iterator(), false };
+        }
+        return { insert_unsafe(pos, it, path), true };
+    }
+
+    std::pair<iterator, bool> insert_unique(iterator hint, const value_type &value) {
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(hint, m_kov_(value), path);
+        if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(pos, create_node(value), path), true };
+    }
+
+    std::pair<iterator, bool> insert_unique(iterator hint, value_type &&value) {
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(hint, m_kov_(value), path);
+        if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(pos, create_node(std::move(value)), path), true };
+    }
+
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace_hint_unique(iterator hint, Args&& ... args) {
+        iterator it = create_node(std::forward<Args>(args)...);
+        iterator path[MaxFloorNumber];
+        iterator pos = insert_search(hint, m_kov_(*it), path);
         if (pos != end() && m_c_.less_or_equal(m_kov_(*pos), m_kov_(*it))) {
             destory_node(it);
             return { iterator(), false };
         }
-        return { insert_unsafe(pos, it), true };
+        return { insert_unsafe(pos, it, path), true };
     }
 
     iterator erase(iterator pos) {
         iterator it = pos++;
         it = extract_unsafe(it);
-        destory_node(it);
+        retire_node(it);
         return pos;
     }
 
     iterator erase(iterator first, iterator last) {
+        if (first == last) {
+            return last;
+        }
+        splice_unsafe(first, last);
         while (first != last) {
-            first = erase(first);
+            retire_node(first++);
         }
         return last;
     }
 
     iterator erase(const key_type &key) {
-        iterator it = lower_bound(key);
-        while (it != end() && m_c_.less_or_equal(m_kov_(*it), key)) {
-            it = erase(it);
+        iterator first = lower_bound(key);
+        iterator last = first;
+        while (last != end() && m_c_.less_or_equal(m_kov_(*last), key)) {
+            ++last;
         }
-        return it;
+        return erase(first, last);
+    }
+public:
+    /*
+     * 批量插入：输入按键有序时自左向右一次完成，后一个元素从前一个元素的
+     * 查找路径继续；无序时先对迭代器排序。相等元素插在已有相等元素之后，
+     * 并保持输入中的先后次序
+     */
+    template <typename Iterator>
+    size_type insert_equal_batch(Iterator first, Iterator last) {
+        return insert_batch<false>(first, last);
+    }
+
+    template <typename Iterator>
+    size_type insert_unique_batch(Iterator first, Iterator last) {
+        return insert_batch<true>(first, last);
+    }
+
+    template <typename KeyIterator>
+    size_type erase_batch(KeyIterator first, KeyIterator last) {
+        if (std::is_sorted(first, last, [this](const key_type &a, const key_type &b) {
+                return m_c_.less(a, b);
+            })) {
+            return erase_batch_unsafe(first, last);
+        }
+
+        std::vector<key_type> keys(first, last);
+        std::sort(keys.begin(), keys.end(), [this](const key_type &a, const key_type &b) {
+            return m_c_.less(a, b);
+        });
+        return erase_batch_unsafe(keys.begin(), keys.end());
     }
 public:
     void unique() {
@@ -532,34 +1174,960 @@ public:
         while (it != end()) {
             iterator tmp = it;
             ++tmp;
-            if (tmp == end() || m_c_.greater(m_kov_(*tmp), m_kov_(*it))) {
-                it = tmp;
-            } else {
-                erase(tmp);
+            while (tmp != end() && m_c_.less_or_equal(m_kov_(*tmp), m_kov_(*it))) {
+                ++tmp;
             }
+            erase(++iterator(it), tmp);
+            it = tmp;
         }
     }
-private:
-    iterator extract_unsafe(iterator it) {
-        floor_number_type fn = it.floor_number();
-        for (floor_number_type ifn = 0; ifn < fn; ++ifn) {
-            iterator npos = it.get_index_next(ifn);
-            iterator ppos = it.get_index_prev(ifn);
-
-            npos.set_prev_floor(ifn, ppos);
-            ppos.set_next_floor(ifn, npos);
+public:
+    /*
+     * 以下集合运算都只按序遍历两个表的第 0 层一次，并在同一遍中按新的次序
+     * 重建各层链接，时间复杂度 O(n + m)。相等元素按多重集合的语义逐个配对
+     */
+
+    /*
+     * 把 other 的全部元素并入本表，相等元素中本表的在前，other 变为空表。
+     * 节点池支持 absorb() 或两个分配器相等时直接转移节点，不重新分配；
+     * 否则把元素移入本表新分配的节点
+     */
+    void merge(self &other) {
+        if (this == &other) {
+            return;
+        }
+        other.drain_epoch();
+
+        bool steal = true;
+        if constexpr (__detail::has_absorb<node_allocator_type>::value) {
+            m_alloc_.absorb(other.m_alloc_);
+        } else {
+            steal = m_alloc_ == other.m_alloc_;
+        }
+
+        if (steal) {
+            iterator a = begin();
+            iterator b = other.begin();
+            relink([&]() {
+                if (b == other.end() ||
+                    (a != end() && m_c_.less_or_equal(m_kov_(*a), m_kov_(*b)))) {
+                    return a == end() ? end() : a++;
+                }
+                return b++;
+            });
+            other.reset_head();
+            other.reset_finger();
+            other.m_size_ = 0;
+            other.m_fn_ = 0;
+        } else {
+            std::vector<iterator> nodes = create_nodes(other.size(), [&other](auto f) {
+                for (auto &i : other) {
+                    f(std::move(i));
+                }
+            });
+            merge_nodes(nodes);
+            other.clear();
+        }
+    }
+
+    /*
+     * 加入 other 中没有配对的元素的副本，本表已有的节点保持不动
+     */
+    void set_union(const self &other) {
+        std::vector<iterator> nodes = create_nodes(other.size(), [this, &other](auto f) {
+            iterator a = begin();
+            for (iterator b = other.begin(); b != other.end(); ++b) {
+                while (a != end() && m_c_.less(m_kov_(*a), m_kov_(*b))) {
+                    ++a;
+                }
+                if (a != end() && m_c_.equal(m_kov_(*a), m_kov_(*b))) {
+                    ++a;
+                } else {
+                    f(*b);
+                }
+            }
+        });
+        merge_nodes(nodes);
+    }
+
+    /*
+     * 只保留在 other 中有配对的元素
+     */
+    void set_intersection(const self &other) {
+        filter(other, true);
+    }
+
+    /*
+     * 删除在 other 中有配对的元素
+     */
+    void set_difference(const self &other) {
+        filter(other, false);
+    }
+
+    /*
+     * 把键不小于 key 的元素切分到返回的新表中，只改写切口两侧各层的链接，
+     * 节点留在原处。节点池支持 share() 时新表与本表共同持有原有的 slab；
+     * 分配器不相等且不支持 share() 时退化为移动元素。
+     * IndexedLinkPolicy 下为 O(log n)，其余策略还需沿第 0 层从两端同时
+     * 计数较短的一侧来得到两表的大小
+     */
+    self split(const key_type &key) {
+        self upper(default_probability, get_allocator());
+        upper.m_c_ = m_c_;
+        upper.m_lg_ = m_lg_.fork();
+        upper.m_kov_ = m_kov_;
+        upper.enable_finger(finger_enabled());
+        if constexpr (published) {
+            upper.enable_epoch(epoch_enabled());
+        }
+
+        iterator path[MaxFloorNumber];
+        size_type rank[MaxFloorNumber];
+        size_type r = 0;
+        iterator it = end();
+        for (floor_number_type fn = m_fn_; fn--;) {
+            iterator next = it.get_index_next(fn);
+            while (next != end() && m_c_.less(m_kov_(*next), key)) {
+                if constexpr (link_policy::indexed) {
+                    r += it.get_width(fn);
+                }
+                it = next;
+                next = it.get_index_next(fn);
+            }
+            path[fn] = it;
+            rank[fn] = r;
+        }
+
+        iterator first = it.get_index_next(0);
+        if (first == end()) {
+            return upper;
+        }
+
+        bool steal = true;
+        if constexpr (__detail::has_share<node_allocator_type>::value) {
+            upper.m_alloc_.share(m_alloc_);
+        } else {
+            steal = upper.m_alloc_ == m_alloc_;
+        }
+        if (!steal) {
+            upper.append_unsafe(std::make_move_iterator(first), std::make_move_iterator(end()));
+            erase(first, end());
+            return upper;
+        }
 
-            it.set_prev_floor(ifn, it);
-            it.set_next_floor(ifn, it);
+        size_type k = r;
+        if constexpr (!link_policy::indexed) {
+            iterator a = begin();
+            iterator b = first;
+            size_type n = 0;
+            while (a != first && b != end()) {
+                ++a;
+                ++b;
+                ++n;
+            }
+            k = a == first ? n : m_size_ - n;
+        }
+
+        iterator tail[MaxFloorNumber];
+        last_path(tail);
+        floor_number_type fn = 0;
+        for (; fn < m_fn_ && path[fn].get_index_next(fn) != end(); ++fn) {
+            iterator next = path[fn].get_index_next(fn);
+            size_type next_rank = 0;
+            if constexpr (link_policy::indexed) {
+                next_rank = rank[fn] + path[fn].get_width(fn) - k;
+            }
+            link_tail(upper.end(), 0, next, next_rank, fn);
+            tail[fn].set_next_floor(fn, upper.end());
+            if constexpr (full_backward || bottom_backward) {
+                if (full_backward || fn == 0) {
+                    upper.end().set_prev_floor(fn, tail[fn]);
+                }
+            }
+        }
+        upper.m_size_ = m_size_ - k;
+        upper.m_fn_ = fn;
+
+        m_size_ = k;
+        close_tail(path, rank);
+        while (m_fn_ && path[m_fn_ - 1] == end()) {
+            --m_fn_;
+        }
+        reset_finger();
+        return upper;
+    }
+
+    /*
+     * 把 other 的全部元素接在本表之后，other 变为空表。调用者需保证 other
+     * 中的键都不小于本表的最后一个键。只改写本表各层最后一个节点与 other
+     * 各层第一个节点之间的链接，节点池支持 absorb() 或两个分配器相等时
+     * 节点留在原处，期望 O(log n)；否则退化为移动元素
+     */
+    void join(self &other) {
+        if (this == &other || other.empty()) {
+            return;
+        }
+        other.drain_epoch();
+
+        bool steal = true;
+        if constexpr (__detail::has_absorb<node_allocator_type>::value) {
+            m_alloc_.absorb(other.m_alloc_);
+        } else {
+            steal = m_alloc_ == other.m_alloc_;
+        }
+        if (!steal) {
+            append_unsafe(std::make_move_iterator(other.begin()),
+                          std::make_move_iterator(other.end()));
+            other.clear();
+            return;
+        }
+
+        iterator tail[MaxFloorNumber];
+        iterator otail[MaxFloorNumber];
+        last_path(tail);
+        other.last_path(otail);
+        for (floor_number_type fn = 0; fn < std::max(m_fn_, other.m_fn_); ++fn) {
+            if (fn >= other.m_fn_) {
+                if constexpr (link_policy::indexed) {
+                    tail[fn].set_width(fn, tail[fn].get_width(fn) + other.m_size_);
+                }
+                continue;
+            }
+
+            size_type rank = 0;
+            size_type next_rank = 0;
+            if constexpr (link_policy::indexed) {
+                rank = fn < m_fn_ ? m_size_ + 1 - tail[fn].get_width(fn) : 0;
+                next_rank = m_size_ + other.end().get_width(fn);
+            }
+            link_tail(tail[fn], rank, other.end().get_index_next(fn), next_rank, fn);
+            otail[fn].set_next_floor(fn, end());
+            if constexpr (full_backward || bottom_backward) {
+                if (full_backward || fn == 0) {
+                    end().set_prev_floor(fn, otail[fn]);
+                }
+            }
+        }
+        m_size_ += other.m_size_;
+        m_fn_ = std::max(m_fn_, other.m_fn_);
+        reset_finger();
+
+        other.reset_head();
+        other.reset_finger();
+        other.m_size_ = 0;
+        other.m_fn_ = 0;
+    }
+private:
+    /*
+     * 各层的最后一个节点，没有节点的层为头节点
+     */
+    void last_path(iterator *path) const {
+        if constexpr (full_backward) {
+            for (floor_number_type fn = 0; fn < MaxFloorNumber; ++fn) {
+                path[fn] = end().get_index_prev(fn);
+            }
+        } else {
+            prev_path(end(), path);
+        }
+    }
+
+    /*
+     * 依次链接 next() 返回的节点直到其返回 end()，重建全部各层链接与跨度。
+     * 调用者需保证 next() 读取某个节点的后继先于该节点被重新链接
+     */
+    template <typename Next>
+    void relink(Next next) {
+        iterator tail[MaxFloorNumber];
+        size_type rank[MaxFloorNumber];
+        std::fill_n(tail, MaxFloorNumber, end());
+        std::fill_n(rank, MaxFloorNumber, 0);
+
+        size_type r = 0;
+        floor_number_type fn = 0;
+        for (iterator it = next(); it != end(); it = next()) {
+            ++r;
+            for (floor_number_type ifn = 0; ifn < it.floor_number(); ++ifn) {
+                link_tail(tail[ifn], rank[ifn], it, r, ifn);
+                tail[ifn] = it;
+                rank[ifn] = r;
+            }
+            fn = std::max(fn, it.floor_number());
+        }
+
+        m_size_ = r;
+        m_fn_ = std::max(m_fn_, fn);
+        close_tail(tail, rank);
+        m_fn_ = fn;
+        reset_finger();
+    }
+
+    /*
+     * 为 gen(f) 依次传给 f 的值创建节点，至多 hint 个；中途失败时销毁已创建的节点
+     */
+    template <typename Gen>
+    std::vector<iterator> create_nodes(size_type hint, Gen gen) {
+        std::vector<iterator> nodes;
+        nodes.reserve(hint);
+        size_type size = m_size_;
+        try {
+            gen([this, &nodes](auto &&value) {
+                nodes.push_back(create_node(std::forward<decltype(value)>(value)));
+            });
+        } catch (...) {
+            for (iterator it : nodes) {
+                free_node(it);
+            }
+            m_size_ = size;
+            throw;
+        }
+        return nodes;
+    }
+
+    /*
+     * 把按序排列的新节点与本表归并，相等元素中本表的在前
+     */
+    void merge_nodes(const std::vector<iterator> &nodes) {
+        iterator a = begin();
+        auto b = nodes.begin();
+        relink([&]() {
+            if (b == nodes.end() ||
+                (a != end() && m_c_.less_or_equal(m_kov_(*a), m_kov_(**b)))) {
+                return a == end() ? end() : a++;
+            }
+            return *b++;
+        });
+    }
+
+    void filter(const self &other, bool keep) {
+        if (this == &other) {
+            if (!keep) {
+                clear();
+            }
+            return;
+        }
+        iterator a = begin();
+        iterator b = other.begin();
+        relink([&]() {
+            while (a != end()) {
+                while (b != other.end() && m_c_.less(m_kov_(*b), m_kov_(*a))) {
+                    ++b;
+                }
+                bool paired = b != other.end() && m_c_.equal(m_kov_(*a), m_kov_(*b));
+                if (paired) {
+                    ++b;
+                }
+                iterator it = a++;
+                if (paired == keep) {
+                    return it;
+                }
+                retire_node(it);
+            }
+            return end();
+        });
+    }
+private:
+    /*
+     * 将 [first, last) 整体从各层摘下：每层只把区间前的最后一个节点与
+     * 区间后的第一个节点相连，区间内节点自身的链接保持不变
+     */
+    void splice_unsafe(iterator first, iterator last) {
+        if constexpr (!full_backward) {
+            iterator path[MaxFloorNumber];
+            iterator tail[MaxFloorNumber];
+            floor_number_type fn = 0;
+            prev_path(first, path);
+            for (iterator it = first; it != last; ++it) {
+                std::fill_n(tail, it.floor_number(), it);
+                fn = std::max(fn, it.floor_number());
+            }
+
+            for (floor_number_type ifn = 0; ifn < fn; ++ifn) {
+                path[ifn].set_next_floor(ifn, tail[ifn].get_index_next(ifn));
+                if (m_finger_) {
+                    m_finger_[ifn] = path[ifn];
+                }
+            }
+            if constexpr (bottom_backward) {
+                last.set_prev_floor(0, path[0]);
+            }
+        } else {
+            iterator ppos = first.get_index_prev(0);
+            iterator npos = last;
+            floor_number_type fn = 0;
+            size_type lw = 1;
+            size_type rw = 0;
+
+            while (fn < m_fn_) {
+                while (ppos.floor_number() <= fn) {
+                    iterator tmp = ppos.get_min_link();
+                    if constexpr (link_policy::indexed) {
+                        lw += tmp.get_width(ppos.floor_number() - 1);
+                    }
+                    ppos = tmp;
+                }
+                while (npos.floor_number() <= fn) {
+                    if constexpr (link_policy::indexed) {
+                        rw += npos.get_width(npos.floor_number() - 1);
+                    }
+                    npos = npos.get_max_link();
+                }
+                if (ppos.get_index_next(fn) == npos) {
+                    break;
+                }
+
+                ppos.set_next_floor(fn, npos);
+                npos.set_prev_floor(fn, ppos);
+                if constexpr (link_policy::indexed) {
+                    ppos.set_width(fn, lw + rw);
+                }
+                if (m_finger_) {
+                    m_finger_[fn] = ppos;
+                }
+                ++fn;
+            }
+
+            if constexpr (link_policy::indexed) {
+                size_type k = 0;
+                for (iterator it = first; it != last; ++it) {
+                    ++k;
+                }
+                for (; fn < m_fn_; ++fn) {
+                    while (ppos.floor_number() <= fn) {
+                        ppos = ppos.get_min_link();
+                    }
+                    ppos.set_width(fn, ppos.get_width(fn) - k);
+                }
+            }
+        }
+
+        shrink_floor_number();
+    }
+
+    iterator extract_unsafe(iterator it) {
+        if constexpr (link_policy::indexed) {
+            extract_width_unsafe(it);
+        }
+
+        iterator path[MaxFloorNumber];
+        if constexpr (!full_backward) {
+            prev_path(it, path);
+        }
+
+        floor_number_type fn = it.floor_number();
+        for (floor_number_type ifn = 0; ifn < fn; ++ifn) {
+            iterator npos = it.get_index_next(ifn);
+            iterator ppos;
+            if constexpr (full_backward) {
+                ppos = it.get_index_prev(ifn);
+            } else {
+                ppos = path[ifn];
+            }
+
+            if (m_finger_ && m_finger_[ifn] == it) {
+                m_finger_[ifn] = ppos;
+            }
+
+            if constexpr (full_backward || bottom_backward) {
+                if (full_backward || ifn == 0) {
+                    npos.set_prev_floor(ifn, ppos);
+                    it.set_prev_floor(ifn, it);
+                }
+            }
+            ppos.set_next_floor(ifn, npos);
+            /* 发布模式下停在 it 上的读者仍需沿原来的后继继续前进 */
+            if constexpr (!published) {
+                it.set_next_floor(ifn, it);
+            }
+        }
+
+        shrink_floor_number();
+        return it;
+    }
+private:
+    /*
+     * 从上一次查找留下的路径出发：m_finger_[fn] 为第 fn 层上位于上次
+     * 目标之前的节点。自底向上找到第一层能夹住 key 的位置后再向下查找，
+     * 并用新的路径覆盖 m_finger_。
+     */
+    template <bool Upper>
+    iterator finger_search(const key_type &key) const {
+        ++m_finger_stats_.searches;
+        floor_number_type fn = 0;
+        iterator it = path_search<Upper>(key, m_finger_.get(), fn);
+        if (fn + 1 < m_fn_) {
+            ++m_finger_stats_.reused;
+            m_finger_stats_.skipped_floors += m_fn_ - fn - 1;
         }
         return it;
     }
+
+    /*
+     * path 为各层的起点，查找结束后被更新为新的查找路径；
+     * fn 返回本次查找开始下降的层
+     */
+    template <bool Upper>
+    iterator path_search(const key_type &key, iterator *path,
+                         floor_number_type &fn) const {
+        auto before = [this](const key_type &k, const key_type &key) {
+            return Upper ? m_c_.less_or_equal(k, key) : m_c_.less(k, key);
+        };
+
+        fn = 0;
+        if (!m_fn_) {
+            return end();
+        }
+
+        iterator it = path[fn];
+        while (fn + 1 < m_fn_) {
+            if (it == end() || before(m_kov_(*it), key)) {
+                iterator next = it.get_index_next(fn);
+                if (next == end() || !before(m_kov_(*next), key)) {
+                    break;
+                }
+            }
+            it = path[++fn];
+        }
+        if (it != end() && !before(m_kov_(*it), key)) {
+            it = end();
+        }
+
+        iterator next = it;
+        floor_number_type ifn = fn + 1;
+        while (ifn--) {
+            next = it.get_index_next(ifn);
+            while (next != end() && before(m_kov_(*next), key)) {
+                it = next;
+                next = it.get_index_next(ifn);
+            }
+            path[ifn] = it;
+        }
+        return next;
+    }
+
+    template <typename Iterator>
+    void append_unsafe(Iterator first, Iterator last) {
+        iterator tail[MaxFloorNumber];
+        size_type rank[MaxFloorNumber];
+        if constexpr (!full_backward) {
+            prev_path(end(), tail);
+        }
+        for (floor_number_type fn = 0; fn < MaxFloorNumber; ++fn) {
+            if constexpr (full_backward) {
+                tail[fn] = end().get_index_prev(fn);
+            }
+            if constexpr (link_policy::indexed) {
+                rank[fn] = fn < m_fn_ ? m_size_ + 1 - tail[fn].get_width(fn) : 0;
+            }
+        }
+
+        try {
+            while (first != last) {
+                iterator it = create_node(*first++);
+                floor_number_type itfn = it.floor_number();
+                for (floor_number_type fn = 0; fn < itfn; ++fn) {
+                    if constexpr (link_policy::indexed) {
+                        tail[fn].set_width(fn, m_size_ - rank[fn]);
+                        rank[fn] = m_size_;
+                    }
+                    if constexpr (full_backward || bottom_backward) {
+                        if (full_backward || fn == 0) {
+                            it.set_prev_floor(fn, tail[fn]);
+                        }
+                    }
+                    tail[fn].set_next_floor(fn, it);
+                    tail[fn] = it;
+                }
+                raise_floor_number(itfn);
+            }
+        } catch (...) {
+            close_tail(tail, rank);
+            throw;
+        }
+        close_tail(tail, rank);
+    }
+
+    /*
+     * 在 n 个线程上执行 f(0) ... f(n - 1)，全部结束后重新抛出第一个异常
+     */
+    template <typename F>
+    static void parallel_for(size_type n, F f) {
+        std::vector<std::exception_ptr> errors(n);
+        auto run = [&f, &errors](size_type i) {
+            try {
+                f(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (size_type i = 1; i < n; ++i) {
+            workers.emplace_back(run, i);
+        }
+        run(0);
+        for (auto &t : workers) {
+            t.join();
+        }
+        for (auto &e : errors) {
+            if (e) {
+                std::rethrow_exception(e);
+            }
+        }
+    }
+
+    void parallel_sort(std::vector<value_type> &values, const std::vector<size_type> &bounds) const {
+        auto less = [this](const value_type &a, const value_type &b) {
+            return m_c_.less(m_kov_(a), m_kov_(b));
+        };
+        auto at = [&values, &bounds](size_type i) {
+            return values.begin() + bounds[std::min(i, bounds.size() - 1)];
+        };
+
+        size_type chunks = bounds.size() - 1;
+        parallel_for(chunks, [&](size_type i) {
+            std::stable_sort(at(i), at(i + 1), less);
+        });
+        for (size_type width = 1; width < chunks; width *= 2) {
+            parallel_for((chunks + 2 * width - 1) / (2 * width), [&](size_type i) {
+                size_type lo = i * 2 * width;
+                std::inplace_merge(at(lo), at(lo + width), at(lo + 2 * width), less);
+            });
+        }
+    }
+
+    /*
+     * 把有序的 values 追加到空表中：每段的节点按段内次序链接，并记录段在
+     * 各层上的首尾节点及其排名，之后串行地把相邻段首尾相连
+     */
+    void parallel_append(std::vector<value_type> &values, const std::vector<size_type> &bounds) {
+        struct Chunk {
+            iterator first[MaxFloorNumber];
+            iterator last[MaxFloorNumber];
+            size_type first_rank[MaxFloorNumber];
+            size_type last_rank[MaxFloorNumber];
+            floor_number_type fn = 0;
+            size_type constructed = 0;
+        };
+
+        size_type chunks = bounds.size() - 1;
+        std::vector<Chunk> state(chunks);
+        std::vector<std::conditional_t<(MaxFloorNumber < 256), unsigned char, floor_number_type>>
+            heights(values.size());
+        std::vector<skip_list_node *> nodes(values.size());
+
+        std::vector<level_generator_type> generators;
+        generators.reserve(chunks);
+        for (size_type c = 0; c < chunks; ++c) {
+            generators.push_back(m_lg_.fork());
+        }
+        parallel_for(chunks, [&](size_type c) {
+            for (size_type i = bounds[c]; i < bounds[c + 1]; ++i) {
+                heights[i] = std::min<floor_number_type>(MaxFloorNumber, generators[c]());
+            }
+        });
+
+        size_type allocated = 0;
+        try {
+            for (; allocated < values.size(); ++allocated) {
+                nodes[allocated] = (skip_list_node *)node_allocator_traits::allocate(
+                    m_alloc_, node_size(heights[allocated]));
+            }
+
+            parallel_for(chunks, [&](size_type c) {
+                Chunk &chunk = state[c];
+                std::allocator<skip_list_node> alloc;
+                for (size_type i = bounds[c]; i < bounds[c + 1]; ++i) {
+                    std::allocator_traits<std::allocator<skip_list_node>>().construct(
+                        alloc, nodes[i], heights[i], std::move(values[i]));
+                    ++chunk.constructed;
+
+                    iterator it(nodes[i]);
+                    for (floor_number_type fn = 0; fn < heights[i]; ++fn) {
+                        if (fn < chunk.fn) {
+                            link_tail(chunk.last[fn], chunk.last_rank[fn], it, i + 1, fn);
+                        } else {
+                            chunk.first[fn] = it;
+                            chunk.first_rank[fn] = i + 1;
+                        }
+                        chunk.last[fn] = it;
+                        chunk.last_rank[fn] = i + 1;
+                    }
+                    chunk.fn = std::max<floor_number_type>(chunk.fn, heights[i]);
+                }
+            });
+        } catch (...) {
+            std::allocator<skip_list_node> alloc;
+            for (size_type c = 0; c < chunks; ++c) {
+                for (size_type i = bounds[c]; i < bounds[c] + state[c].constructed; ++i) {
+                    std::allocator_traits<std::allocator<skip_list_node>>().destroy(alloc, nodes[i]);
+                }
+            }
+            for (size_type i = 0; i < allocated; ++i) {
+                node_allocator_traits::deallocate(m_alloc_, (char *)nodes[i], node_size(heights[i]));
+            }
+            throw;
+        }
+
+        iterator tail[MaxFloorNumber];
+        size_type rank[MaxFloorNumber];
+        std::fill_n(tail, MaxFloorNumber, end());
+        std::fill_n(rank, MaxFloorNumber, 0);
+        for (const Chunk &chunk : state) {
+            for (floor_number_type fn = 0; fn < chunk.fn; ++fn) {
+                link_tail(tail[fn], rank[fn], chunk.first[fn], chunk.first_rank[fn], fn);
+                tail[fn] = chunk.last[fn];
+                rank[fn] = chunk.last_rank[fn];
+            }
+            raise_floor_number(chunk.fn);
+        }
+        m_size_ = values.size();
+        close_tail(tail, rank);
+    }
+
+    /*
+     * 在第 fn 层把排名为 itrank 的 it 接在排名为 tailrank 的 tail 之后
+     */
+    static void link_tail(iterator tail, size_type tailrank, iterator it, size_type itrank,
+                          floor_number_type fn) {
+        tail.set_next_floor(fn, it);
+        if constexpr (full_backward || bottom_backward) {
+            if (full_backward || fn == 0) {
+                it.set_prev_floor(fn, tail);
+            }
+        }
+        if constexpr (link_policy::indexed) {
+            tail.set_width(fn, itrank - tailrank);
+        }
+    }
+
+    void close_tail(iterator *tail, size_type *rank) {
+        for (floor_number_type fn = 0; fn < m_fn_; ++fn) {
+            tail[fn].set_next_floor(fn, end());
+            if constexpr (full_backward || bottom_backward) {
+                if (full_backward || fn == 0) {
+                    end().set_prev_floor(fn, tail[fn]);
+                }
+            }
+            if constexpr (link_policy::indexed) {
+                tail[fn].set_width(fn, m_size_ + 1 - rank[fn]);
+            }
+        }
+    }
+
+    template <size_type Group, bool Find, typename KeyIterator, typename OutputIterator>
+    OutputIterator interleaved_search(KeyIterator first, KeyIterator last,
+                                      OutputIterator out) const {
+        static_assert(Group > 0, "Group should greater than zero!");
+
+        struct State {
+            KeyIterator key;
+            iterator it;
+            iterator next;
+            floor_number_type fn;
+            bool done;
+        };
+
+        State st[Group];
+        while (first != last) {
+            size_type n = 0;
+            size_type active = 0;
+            for (; n < Group && first != last; ++n, ++first) {
+                State &s = st[n];
+                s.key = first;
+                s.it = end();
+                s.next = end();
+                s.fn = 0;
+                s.done = !m_fn_;
+                if (!s.done) {
+                    s.fn = m_fn_ - 1;
+                    s.next = s.it.get_index_next(s.fn);
+                    s.next.prefetch(s.fn, end());
+                    ++active;
+                }
+            }
+
+            while (active) {
+                for (size_type i = 0; i < n; ++i) {
+                    State &s = st[i];
+                    if (s.done) {
+                        continue;
+                    }
+
+                    if (s.next != end() && m_c_.less(m_kov_(*s.next), *s.key)) {
+                        s.it = s.next;
+                    } else if (s.fn) {
+                        --s.fn;
+                    } else {
+                        s.done = true;
+                        --active;
+                        continue;
+                    }
+                    s.next = s.it.get_index_next(s.fn);
+                    s.next.prefetch(s.fn, end());
+                }
+            }
+
+            for (size_type i = 0; i < n; ++i) {
+                iterator pos = st[i].next;
+                if (Find && pos != end() && m_c_.greater(m_kov_(*pos), *st[i].key)) {
+                    pos = end();
+                }
+                *out++ = pos;
+            }
+        }
+        return out;
+    }
+
+    template <bool Unique, typename Iterator>
+    size_type insert_batch(Iterator first, Iterator last) {
+        auto less = [this](const value_type &a, const value_type &b) {
+            return m_c_.less(m_kov_(a), m_kov_(b));
+        };
+
+        if (std::is_sorted(first, last, less)) {
+            return insert_batch_unsafe<Unique>(first, last, [](const Iterator &it) -> decltype(auto) {
+                return *it;
+            });
+        }
+
+        std::vector<Iterator> its;
+        for (Iterator it = first; it != last; ++it) {
+            its.push_back(it);
+        }
+        std::stable_sort(its.begin(), its.end(), [&less](const Iterator &a, const Iterator &b) {
+            return less(*a, *b);
+        });
+        return insert_batch_unsafe<Unique>(its.begin(), its.end(),
+            [](const typename std::vector<Iterator>::iterator &it) -> decltype(auto) {
+                return **it;
+            });
+    }
+
+    template <bool Unique, typename Iterator, typename Deref>
+    size_type insert_batch_unsafe(Iterator first, Iterator last, Deref deref) {
+        iterator path[MaxFloorNumber];
+        std::fill_n(path, MaxFloorNumber, end());
+        floor_number_type fn;
+        size_type n = 0;
+
+        while (first != last) {
+            auto &&value = deref(first);
+            ++first;
+
+            iterator pos = path_search<!Unique>(m_kov_(value), path, fn);
+            if (Unique && pos != end() &&
+                m_c_.less_or_equal(m_kov_(*pos), m_kov_(value))) {
+                continue;
+            }
+
+            iterator it = insert_unsafe(
+                pos, create_node(std::forward<decltype(value)>(value)), path);
+            std::fill_n(path, it.floor_number(), it);
+            ++n;
+        }
+        return n;
+    }
+
+    template <typename KeyIterator>
+    size_type erase_batch_unsafe(KeyIterator first, KeyIterator last) {
+        iterator path[MaxFloorNumber];
+        std::fill_n(path, MaxFloorNumber, end());
+        floor_number_type fn;
+        size_type n = 0;
+
+        while (first != last) {
+            auto &&key = *first;
+            ++first;
+
+            iterator lo = path_search<false>(key, path, fn);
+            iterator hi = lo;
+            while (hi != end() && m_c_.less_or_equal(m_kov_(*hi), key)) {
+                ++hi;
+                ++n;
+            }
+            erase(lo, hi);
+        }
+        return n;
+    }
+
+    void reset_finger() {
+        if (m_finger_) {
+            std::fill_n(m_finger_.get(), MaxFloorNumber, end());
+        }
+    }
 private:
+    /*
+     * 插入位置的查找。没有逐层反向链接时同时在 path 中记录各层前驱，
+     * 供 insert_unsafe 使用；hint 的塔只能给出其高度以下各层的前驱，
+     * 因此这时不使用 hint
+     */
+    iterator insert_search(iterator hint, const key_type &key, iterator *path) const {
+        if constexpr (full_backward) {
+            return lower_bound(hint, key);
+        } else {
+            if (m_finger_) {
+                iterator pos = finger_search<false>(key);
+                std::copy_n(m_finger_.get(), MaxFloorNumber, path);
+                return pos;
+            }
+            floor_number_type fn;
+            std::fill_n(path, MaxFloorNumber, end());
+            return path_search<false>(key, path, fn);
+        }
+    }
+
+    /*
+     * 各层上位于 it 之前的最后一个节点。先求出键严格小于 it 的查找路径，
+     * 再沿第 0 层走过 it 之前与其相等的节点
+     */
+    void prev_path(iterator it, iterator *path) const {
+        floor_number_type fn = MaxFloorNumber;
+        iterator ppos = end();
+        while (fn-- > m_fn_) {
+            path[fn] = end();
+        }
+        for (fn = m_fn_; fn--;) {
+            iterator next = ppos.get_index_next(fn);
+            while (next != end() &&
+                   (it == end() || m_c_.less(m_kov_(*next), m_kov_(*it)))) {
+                ppos = next;
+                next = ppos.get_index_next(fn);
+            }
+            path[fn] = ppos;
+        }
+        for (ppos = ppos.get_index_next(0); ppos != it; ++ppos) {
+            std::fill_n(path, ppos.floor_number(), ppos);
+        }
+    }
+
+    /*
+     * path 为各层的前驱，仅在没有逐层反向链接时使用
+     */
+    iterator insert_unsafe(iterator pos, iterator it, iterator *path) {
+        if constexpr (full_backward) {
+            return insert_unsafe(pos, it);
+        } else {
+            floor_number_type itfn = it.floor_number();
+            for (floor_number_type fn = 0; fn < itfn; ++fn) {
+                it.set_next_floor(fn, path[fn].get_index_next(fn));
+                path[fn].set_next_floor(fn, it);
+            }
+            if constexpr (bottom_backward) {
+                it.set_prev_floor(0, path[0]);
+                pos.set_prev_floor(0, it);
+            }
+            raise_floor_number(itfn);
+            return it;
+        }
+    }
+
     iterator insert_unsafe(iterator pos, iterator it) {
         floor_number_type itfn = it.floor_number();
         floor_number_type posfn = pos.floor_number();
         floor_number_type fn = 0;
 
+        floor_number_type oldfn = m_fn_;
+        raise_floor_number(itfn);
         while (fn < itfn) {
             iterator ppos = pos.get_index_prev(fn);
 
@@ -570,14 +2138,82 @@ private:
 
             ++fn;
 
-            while (fn >= posfn) {
+            while (fn < itfn && fn >= posfn) {
                 pos = pos.get_max_link();
                 posfn = pos.floor_number();
             }
         }
 
+        if constexpr (link_policy::indexed) {
+            insert_width_unsafe(it, oldfn);
+        }
         return it;
     }
+
+    /*
+     * 节点已链入各层后修正跨度：沿前驱一路向左上爬升，d 为当前层前驱
+     * 到新节点的距离；原本为空的层中头节点的跨度视为 size
+     */
+    void insert_width_unsafe(iterator it, floor_number_type oldfn) {
+        floor_number_type itfn = it.floor_number();
+        iterator ppos = it.get_index_prev(0);
+        size_type d = 1;
+
+        for (floor_number_type fn = 0; fn < m_fn_; ++fn) {
+            while (ppos.floor_number() <= fn) {
+                iterator tmp = ppos.get_index_prev(fn - 1);
+                d += tmp.get_width(fn - 1);
+                ppos = tmp;
+            }
+
+            if (fn < itfn) {
+                size_type w = fn < oldfn ? ppos.get_width(fn) : m_size_;
+                it.set_width(fn, w + 1 - d);
+                ppos.set_width(fn, d);
+            } else {
+                ppos.set_width(fn, ppos.get_width(fn) + 1);
+            }
+        }
+    }
+
+    void extract_width_unsafe(iterator it) {
+        floor_number_type itfn = it.floor_number();
+        iterator ppos = it;
+
+        for (floor_number_type fn = 0; fn < m_fn_; ++fn) {
+            if (fn < itfn) {
+                ppos = it.get_index_prev(fn);
+                ppos.set_width(fn, ppos.get_width(fn) + it.get_width(fn) - 1);
+            } else {
+                while (ppos.floor_number() <= fn) {
+                    ppos = ppos.get_min_link();
+                }
+                ppos.set_width(fn, ppos.get_width(fn) - 1);
+            }
+        }
+    }
+
+    /*
+     * 返回第一个不在 key 之前的节点及其下标
+     */
+    template <bool Upper>
+    std::pair<iterator, size_type> rank_search(const key_type &key) const {
+        floor_number_type fn = m_fn_;
+        size_type r = 0;
+        iterator it = end();
+        iterator next = it;
+        while (fn--) {
+            next = it.get_index_next(fn);
+            while (next != end() &&
+                   (Upper ? m_c_.less_or_equal(m_kov_(*next), key) :
+                    m_c_.less(m_kov_(*next), key))) {
+                r += it.get_width(fn);
+                it = next;
+                next = it.get_index_next(fn);
+            }
+        }
+        return { next, r };
+    }
 private:
     iterator create_head() {
         std::allocator<skip_list_head> alloc;
@@ -592,10 +2228,15 @@ private:
     iterator create_node(Args&& ... args) {
         std::allocator<skip_list_node> alloc;
         floor_number_type fn = floor_number();
-        skip_list_node *p = (skip_list_node *)malloc(
-            sizeof(skip_list_node) + fn * sizeof(floor_type));
-        std::allocator_traits<std::allocator<skip_list_node>>().construct(
-            alloc, p, fn, std::forward<Args>(args)...);
+        skip_list_node *p = (skip_list_node *)node_allocator_traits::allocate(
+            m_alloc_, node_size(fn));
+        try {
+            std::allocator_traits<std::allocator<skip_list_node>>().construct(
+                alloc, p, fn, std::forward<Args>(args)...);
+        } catch (...) {
+            node_allocator_traits::deallocate(m_alloc_, (char *)p, node_size(fn));
+            throw;
+        }
         ++m_size_;
         return iterator(p);
     }
@@ -605,23 +2246,151 @@ private:
     }
 
     void destory_node(iterator it) {
+        free_node(it);
+        --m_size_;
+    }
+
+    void free_node(iterator it) {
         std::allocator<skip_list_node> alloc;
         std::allocator_traits<std::allocator<skip_list_node>>().destroy(
             alloc, it.to_node());
-        free(it.to_node());
-        --m_size_;
+        node_allocator_traits::deallocate(m_alloc_, (char *)it.to_node(),
+                                          node_size(it.floor_number()));
+    }
+
+    /*
+     * 已发布过的节点：开启 epoch 时延迟到没有读者能访问它之后再销毁
+     */
+    void retire_node(iterator it) {
+        if (m_epoch_) {
+            m_epoch_->retire(it.to_node(), &self::reclaim_node, this);
+            --m_size_;
+        } else {
+            destory_node(it);
+        }
+    }
+
+    static void reclaim_node(void *sl, void *node) {
+        ((self *)sl)->free_node(iterator((skip_list_node *)node));
+    }
+
+    void drain_epoch() {
+        if (m_epoch_) {
+            m_epoch_->drain();
+        }
+    }
+
+    /*
+     * 待回收节点引用了 this 与分配器，转移前先全部回收
+     */
+    std::unique_ptr<EpochDomain> release_epoch() {
+        drain_epoch();
+        return std::move(m_epoch_);
+    }
+
+    /*
+     * 沿第 0 层遍历一次直接销毁所有节点，不再逐层拆链；
+     * 值类型可平凡析构且分配器支持 release() 时无需遍历
+     */
+    void destory_all() {
+        drain_epoch();
+
+        constexpr bool release =
+            __detail::has_release<node_allocator_type>::value;
+        constexpr bool trivial =
+            std::is_trivially_destructible<value_type>::value;
+
+        if constexpr (!(release && trivial)) {
+            std::allocator<skip_list_node> alloc;
+            iterator it = begin();
+            while (it != end()) {
+                iterator tmp = it++;
+                if constexpr (!trivial) {
+                    std::allocator_traits<std::allocator<skip_list_node>>().destroy(
+                        alloc, tmp.to_node());
+                }
+                if constexpr (!release) {
+                    node_allocator_traits::deallocate(
+                        m_alloc_, (char *)tmp.to_node(),
+                        node_size(tmp.floor_number()));
+                }
+            }
+        }
+        if constexpr (release) {
+            m_alloc_.release();
+        }
+
+        reset_head();
+        reset_finger();
+        m_size_ = 0;
+        m_fn_ = 0;
+    }
+
+    void reset_head() {
+        std::uninitialized_fill_n(m_it_.to_head()->floor, m_fn_,
+                                  __detail::make_floor<floor_type>(m_it_.base()));
+        if constexpr (bottom_backward) {
+            m_it_.set_prev_floor(0, m_it_);
+        }
+    }
+
+    inline static size_type node_size(floor_number_type fn) {
+        return sizeof(skip_list_node) + fn * sizeof(floor_type);
     }
 
     inline floor_number_type floor_number() {
-        return std::min(MaxFloorNumber, m_gd_(m_dre_) + 1);
+        return std::min<floor_number_type>(MaxFloorNumber, m_lg_());
+    }
+
+    /*
+     * 发布模式下读者与写者并发访问 m_fn_；头节点的各层始终有效，
+     * 读者先看到新的层数、后看到该层的链接也只是经过一层空链表
+     */
+    inline floor_number_type load_floor_number() const {
+        if constexpr (published) {
+            return __atomic_load_n(&m_fn_, __ATOMIC_RELAXED);
+        } else {
+            return m_fn_;
+        }
+    }
+
+    inline void raise_floor_number(floor_number_type fn) {
+        if (fn <= m_fn_) {
+            return;
+        }
+        if constexpr (published) {
+            __atomic_store_n(&m_fn_, fn, __ATOMIC_RELAXED);
+        } else {
+            m_fn_ = fn;
+        }
+    }
+
+    /*
+     * 去掉顶部已经没有节点的层
+     */
+    inline void shrink_floor_number() {
+        floor_number_type fn = m_fn_;
+        while (fn && end().get_index_next(fn - 1) == end()) {
+            --fn;
+        }
+        if constexpr (published) {
+            __atomic_store_n(&m_fn_, fn, __ATOMIC_RELAXED);
+        } else {
+            m_fn_ = fn;
+        }
     }
 private:
+    /* 移动构造时须先于分配器等成员转移，见 release_epoch() */
+    std::unique_ptr<EpochDomain> m_epoch_;
     key_of_value m_kov_;
     comparer m_c_;
-    std::default_random_engine m_dre_;
-    std::geometric_distribution<floor_number_type> m_gd_;
+    level_generator_type m_lg_;
     size_type m_size_;
+    floor_number_type m_fn_;
+    node_allocator_type m_alloc_;
     iterator m_it_;
+    std::unique_ptr<iterator[]> m_finger_;
+    mutable FingerStats m_finger_stats_;
 };
 
 }
@@ -0,0 +1,265 @@
+#ifndef _SKIP_LIST_POOL_HPP__
+#define _SKIP_LIST_POOL_HPP__
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace bit {
+
+/*
+ * 跳表节点池分配器
+ *
+ * 节点大小只取决于塔高，因此按大小分级即按塔高分级：每一级维护独立的
+ * slab 与空闲链表，同一高度的节点分配在相邻的内存中，被释放的节点
+ * 回到其所属级别的空闲链表。release() 一次性归还所有 slab。
+ *
+ * 池不在副本之间共享：拷贝得到的是一个空池，只有移动会转移 slab。
+ * share() 让两个池共同持有同一批 slab（各自维护空闲链表），slab 带有
+ * 引用计数，在最后一个持有者 release() 时才归还。
+ */
+template <typename T>
+class SkipListPool {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = std::false_type;
+
+    template <typename U>
+    struct rebind {
+        using other = SkipListPool<U>;
+    };
+
+    template <typename U>
+    friend class SkipListPool;
+private:
+    constexpr static size_type ALIGN = alignof(std::max_align_t);
+    constexpr static size_type MIN_SLAB_SIZE = 4096;
+    constexpr static size_type MAX_SLAB_SIZE = 64 * 1024;
+
+    struct FreeNode {
+        FreeNode *next;
+    };
+
+    struct Slab {
+        std::atomic<size_type> refs;
+    };
+
+    struct SizeClass {
+        FreeNode *free = nullptr;
+        char *cur = nullptr;
+        char *end = nullptr;
+        size_type slab_size = 0;
+    };
+
+    constexpr static size_type SLAB_HEADER =
+        (sizeof(Slab) + ALIGN - 1) / ALIGN * ALIGN;
+public:
+    SkipListPool() noexcept {
+    }
+
+    SkipListPool(const SkipListPool &) noexcept : SkipListPool() {
+    }
+
+    template <typename U>
+    SkipListPool(const SkipListPool<U> &) noexcept : SkipListPool() {
+    }
+
+    SkipListPool(SkipListPool &&pool) noexcept :
+        m_classes_(std::move(pool.m_classes_)),
+        m_slabs_(std::move(pool.m_slabs_)) {
+        pool.m_classes_.clear();
+        pool.m_slabs_.clear();
+    }
+
+    SkipListPool &operator=(const SkipListPool &) noexcept {
+        return *this;
+    }
+
+    SkipListPool &operator=(SkipListPool &&pool) noexcept {
+        if (this != &pool) {
+            release();
+
+            m_classes_ = std::move(pool.m_classes_);
+            m_slabs_ = std::move(pool.m_slabs_);
+
+            pool.m_classes_.clear();
+            pool.m_slabs_.clear();
+        }
+        return *this;
+    }
+
+    ~SkipListPool() {
+        release();
+    }
+
+    SkipListPool select_on_container_copy_construction() const noexcept {
+        return SkipListPool();
+    }
+
+    T *allocate(size_type n) {
+        size_type cls = size_class(n * sizeof(T));
+        if (cls >= m_classes_.size()) {
+            m_classes_.resize(cls + 1);
+        }
+
+        SizeClass &sc = m_classes_[cls];
+        if (sc.free) {
+            FreeNode *p = sc.free;
+            sc.free = p->next;
+            return (T *)p;
+        }
+
+        size_type bytes = cls * ALIGN;
+        if ((size_type)(sc.end - sc.cur) < bytes) {
+            grow(sc, bytes);
+        }
+        char *p = sc.cur;
+        sc.cur += bytes;
+        return (T *)p;
+    }
+
+    void deallocate(T *p, size_type n) noexcept {
+        SizeClass &sc = m_classes_[size_class(n * sizeof(T))];
+        FreeNode *fn = (FreeNode *)p;
+        fn->next = sc.free;
+        sc.free = fn;
+    }
+
+    /*
+     * 归还全部 slab，调用者需保证池中不再有存活的对象；
+     * 仍被其他池共同持有的 slab 只减少引用计数
+     */
+    void release() noexcept {
+        for (Slab *slab : m_slabs_) {
+            unref(slab);
+        }
+        m_slabs_.clear();
+        m_classes_.clear();
+    }
+
+    /*
+     * 接管 pool 的全部 slab 与空闲节点，pool 中分配出的对象之后可以由本池
+     * 释放；pool 变为空池。每一级只保留两者中剩余空间较大的 slab 尾部
+     */
+    void absorb(SkipListPool &pool) {
+        if (this == &pool || pool.m_slabs_.empty()) {
+            return;
+        }
+        m_slabs_.reserve(m_slabs_.size() + pool.m_slabs_.size());
+
+        if (m_classes_.size() < pool.m_classes_.size()) {
+            m_classes_.resize(pool.m_classes_.size());
+        }
+        for (size_type i = 0; i < pool.m_classes_.size(); ++i) {
+            SizeClass &sc = m_classes_[i];
+            SizeClass &other = pool.m_classes_[i];
+            if (other.free) {
+                FreeNode *tail = other.free;
+                while (tail->next) {
+                    tail = tail->next;
+                }
+                tail->next = sc.free;
+                sc.free = other.free;
+            }
+            if (other.end - other.cur > sc.end - sc.cur) {
+                sc.cur = other.cur;
+                sc.end = other.end;
+            }
+            sc.slab_size = std::max(sc.slab_size, other.slab_size);
+        }
+
+        /* 两个池共同持有的 slab 只保留一份 */
+        m_slabs_.insert(m_slabs_.end(), pool.m_slabs_.begin(), pool.m_slabs_.end());
+        std::sort(m_slabs_.begin(), m_slabs_.end());
+        size_type n = 0;
+        for (Slab *slab : m_slabs_) {
+            if (n && m_slabs_[n - 1] == slab) {
+                unref(slab);
+            } else {
+                m_slabs_[n++] = slab;
+            }
+        }
+        m_slabs_.resize(n);
+
+        pool.m_classes_.clear();
+        pool.m_slabs_.clear();
+    }
+
+    /*
+     * 与 pool 共同持有它的全部 slab，使 pool 中分配出的对象可以由本池释放；
+     * 不接管 pool 的空闲节点与未分配的 slab 尾部，两个池之后的分配互不重叠
+     */
+    void share(const SkipListPool &pool) {
+        if (this == &pool) {
+            return;
+        }
+        if (m_classes_.size() < pool.m_classes_.size()) {
+            m_classes_.resize(pool.m_classes_.size());
+        }
+        m_slabs_.reserve(m_slabs_.size() + pool.m_slabs_.size());
+        for (Slab *slab : pool.m_slabs_) {
+            slab->refs.fetch_add(1, std::memory_order_relaxed);
+            m_slabs_.push_back(slab);
+        }
+    }
+
+    size_type slab_count() const noexcept {
+        return m_slabs_.size();
+    }
+
+    friend inline bool operator==(const SkipListPool &a, const SkipListPool &b) {
+        return &a == &b;
+    }
+
+    friend inline bool operator!=(const SkipListPool &a, const SkipListPool &b) {
+        return !operator==(a, b);
+    }
+private:
+    inline static size_type size_class(size_type bytes) {
+        return (std::max<size_type>(bytes, sizeof(FreeNode)) + ALIGN - 1) / ALIGN;
+    }
+
+    void grow(SizeClass &sc, size_type bytes) {
+        if (sc.slab_size == 0) {
+            sc.slab_size = std::max(MIN_SLAB_SIZE, SLAB_HEADER + bytes);
+        } else if (sc.slab_size < MAX_SLAB_SIZE) {
+            sc.slab_size *= 2;
+        }
+
+        m_slabs_.reserve(m_slabs_.size() + 1);
+        Slab *slab = (Slab *)malloc(sc.slab_size);
+        if (!slab) {
+            throw std::bad_alloc();
+        }
+        new (&slab->refs) std::atomic<size_type>(1);
+        m_slabs_.push_back(slab);
+
+        sc.cur = (char *)slab + SLAB_HEADER;
+        sc.end = (char *)slab + sc.slab_size;
+    }
+
+    static void unref(Slab *slab) noexcept {
+        if (slab->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            slab->refs.~atomic();
+            free(slab);
+        }
+    }
+private:
+    std::vector<SizeClass> m_classes_;
+    std::vector<Slab *> m_slabs_;
+};
+
+} // namespace bit
+
+#endif // _SKIP_LIST_POOL_HPP__
@@ -0,0 +1,814 @@
+#ifndef _UNROLLED_SKIP_LIST_HPP__
+#define _UNROLLED_SKIP_LIST_HPP__
+
+#include "skip_list.hpp"
+
+namespace bit {
+
+namespace __detail {
+
+/*
+ * 一个节点存放至多 N 个有序元素，索引塔以节点中的第一个元素为键
+ */
+template <typename T, std::size_t N>
+struct UnrolledSkipListNode final : public SkipListNodeBase {
+public:
+    std::size_t count;
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    SkipListNodeFloor<false> floor[0];
+public:
+    explicit UnrolledSkipListNode(floor_number_type fn) :
+        SkipListNodeBase(fn), count(0) {
+        std::uninitialized_fill_n(floor, floor_number,
+                                  SkipListNodeFloor<false>{ this, this });
+    }
+
+    T *values() {
+        return reinterpret_cast<T *>(storage);
+    }
+};
+
+} // namespace __detail
+
+/*
+ * 展开跳表：每个节点保存一段连续的元素，节点满时对半分裂，
+ * 过空时与相邻节点合并。顺序遍历与区间扫描基本在连续内存上进行，
+ * 每个元素分摊的链接开销也远小于 SkipList。
+ *
+ * 插入与删除会移动同一节点内的元素，除 end() 外的迭代器随之失效。
+ */
+template <typename Key, typename Value, typename KeyOfValue, typename Compare,
+    typename __detail::SkipListNodeBase::floor_number_type MaxFloorNumber = 32,
+    std::size_t ChunkBytes = 256,
+    typename Allocator = SkipListPool<Value>,
+    typename LevelGenerator = XorshiftLevelGenerator<>>
+class UnrolledSkipList {
+private:
+    using Comparer = __detail::SkipListComparer<Key, Compare>;
+public:
+    using size_type = std::size_t;
+
+    constexpr static size_type CHUNK_CAPACITY =
+        std::max<size_type>(4, ChunkBytes / sizeof(Value));
+
+    class UnrolledSkipListIterator {
+    private:
+        friend UnrolledSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber,
+                                ChunkBytes, Allocator, LevelGenerator>;
+    public:
+        using value_type = Value;
+        using pointer = value_type *;
+        using reference = value_type &;
+
+        using base_type = __detail::SkipListNodeBase *;
+        using self = UnrolledSkipListIterator;
+        using floor_type = __detail::SkipListNodeFloor<false>;
+        using skip_list_head = __detail::SkipListNode<void, floor_type>;
+        using skip_list_node = __detail::UnrolledSkipListNode<value_type, CHUNK_CAPACITY>;
+
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        using iterator_category = std::bidirectional_iterator_tag;
+
+        using floor_number_type =
+            typename __detail::SkipListNodeBase::floor_number_type;
+    public:
+        explicit UnrolledSkipListIterator(base_type pBase = nullptr, size_type index = 0) :
+            m_ptr_(pBase), m_index_(index) {
+        }
+
+        self &operator++() {
+            if (++m_index_ >= to_node()->count) {
+                m_ptr_ = floor()->next;
+                m_index_ = 0;
+            }
+            return *this;
+        }
+
+        self operator++(int) {
+            self tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        self &operator--() {
+            if (m_index_ == 0) {
+                m_ptr_ = floor()->prev;
+                m_index_ = is_head() ? 0 : to_node()->count;
+            }
+            if (m_index_) {
+                --m_index_;
+            }
+            return *this;
+        }
+
+        self operator--(int) {
+            self tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        reference operator*() const {
+            return to_node()->values()[m_index_];
+        }
+
+        pointer operator->() const {
+            return &(this->operator*());
+        }
+
+        explicit operator bool() const {
+            return m_ptr_;
+        }
+
+        base_type base() const {
+            return m_ptr_;
+        }
+
+        friend inline bool operator==(const self &a, const self &b) {
+            return a.m_ptr_ == b.m_ptr_ && a.m_index_ == b.m_index_;
+        }
+
+        friend inline bool operator!=(const self &a, const self &b) {
+            return !operator==(a, b);
+        }
+    private:
+        inline void set_next_floor(floor_number_type fn, self it) {
+            floor()[fn].next = it.m_ptr_;
+        }
+
+        inline void set_prev_floor(floor_number_type fn, self it) {
+            floor()[fn].prev = it.m_ptr_;
+        }
+
+        inline floor_number_type floor_number() const {
+            return m_ptr_->getFloorNumber();
+        }
+
+        inline floor_type *floor() const {
+            return is_head() ? to_head()->floor : to_node()->floor;
+        }
+
+        inline self get_index_prev(floor_number_type fn) const {
+            return self(floor()[fn].prev);
+        }
+
+        inline self get_index_next(floor_number_type fn) const {
+            return self(floor()[fn].next);
+        }
+
+        inline self get_max_link() const {
+            return get_index_next(floor_number() - 1);
+        }
+
+        inline self get_min_link() const {
+            return get_index_prev(floor_number() - 1);
+        }
+
+        inline size_type count() const {
+            return to_node()->count;
+        }
+
+        inline pointer values() const {
+            return to_node()->values();
+        }
+
+        inline skip_list_node *to_node() const {
+            return (skip_list_node *)m_ptr_;
+        }
+
+        inline skip_list_head *to_head() const {
+            return (skip_list_head *)m_ptr_;
+        }
+
+        inline bool is_head() const {
+            return !(m_ptr_->hasLoad());
+        }
+    private:
+        base_type m_ptr_;
+        size_type m_index_;
+    };
+public:
+    using key_type = Key;
+    using value_type = Value;
+
+    using pointer = value_type *;
+    using reference = value_type &;
+
+    using key_of_value = KeyOfValue;
+    using comparer = Comparer;
+
+    using difference_type = std::ptrdiff_t;
+
+    using floor_number_type = typename __detail::SkipListNodeBase::floor_number_type;
+    using floor_type = typename UnrolledSkipListIterator::floor_type;
+
+    using skip_list_head = typename UnrolledSkipListIterator::skip_list_head;
+    using skip_list_node = typename UnrolledSkipListIterator::skip_list_node;
+
+    using allocator_type = Allocator;
+    using node_allocator_type =
+        typename std::allocator_traits<allocator_type>::template rebind_alloc<char>;
+    using node_allocator_traits = std::allocator_traits<node_allocator_type>;
+
+    using level_generator_type = LevelGenerator;
+
+    using self = UnrolledSkipList<Key, Value, KeyOfValue, Compare, MaxFloorNumber,
+                                  ChunkBytes, Allocator, LevelGenerator>;
+
+    /* 构造参数 p 的默认值，含义与 SkipList::default_probability 相同 */
+    constexpr static double default_probability =
+        __detail::level_probability<LevelGenerator>::value;
+
+    using iterator = UnrolledSkipListIterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+public:
+    iterator begin() const {
+        return m_it_.get_index_next(0);
+    }
+
+    iterator end() const {
+        return m_it_;
+    }
+
+    reverse_iterator rbegin() const {
+        return reverse_iterator(end());
+    }
+
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    reference front() {
+        return *begin();
+    }
+
+    const value_type &front() const {
+        return *begin();
+    }
+
+    reference back() {
+        return *(--end());
+    }
+
+    const value_type &back() const {
+        return *(--end());
+    }
+
+    size_type size() const {
+        return m_size_;
+    }
+
+    bool empty() const {
+        return 0 == size();
+    }
+
+    floor_number_type height() const {
+        return m_fn_;
+    }
+
+    size_type chunk_count() const {
+        return m_chunks_;
+    }
+public:
+    size_type count(const key_type &key) const {
+        size_type c = 0;
+        iterator it = lower_bound(key);
+        while (it != end() && m_c_.less_or_equal(m_kov_(*it), key)) {
+            ++it;
+            ++c;
+        }
+        return c;
+    }
+
+    std::pair<iterator, iterator> equal_range(const key_type &key) const {
+        return { lower_bound(key), upper_bound(key) };
+    }
+
+    iterator find(const key_type &key) const {
+        iterator it = lower_bound(key);
+        if (it == end() || m_c_.not_equal(m_kov_(*it), key)) {
+            return end();
+        }
+        return it;
+    }
+
+    bool contain(const key_type &key) const {
+        return end() != find(key);
+    }
+
+    void clear() {
+        destory_all();
+    }
+
+    allocator_type get_allocator() const {
+        return allocator_type(m_alloc_);
+    }
+public:
+    explicit UnrolledSkipList(double p = default_probability,
+                              const allocator_type &alloc = allocator_type()) :
+        m_lg_(p), m_size_(0), m_chunks_(0), m_fn_(0), m_alloc_(alloc),
+        m_it_(create_head()) {
+        static_assert(MaxFloorNumber > 0, "MaxFloorNumber should greater than zero!");
+    }
+
+    template <typename Iterator>
+    explicit UnrolledSkipList(Iterator first, Iterator last, double p = default_probability,
+                              const allocator_type &alloc = allocator_type()) :
+        UnrolledSkipList(p, alloc) {
+        insert_equal(first, last);
+    }
+
+    explicit UnrolledSkipList(std::initializer_list<value_type> ilist, double p = default_probability,
+                              const allocator_type &alloc = allocator_type()) :
+        UnrolledSkipList(p, alloc) {
+        insert_equal(ilist);
+    }
+
+    UnrolledSkipList(const self &sl) :
+        m_kov_(sl.m_kov_),
+        m_c_(sl.m_c_),
+        m_lg_(sl.m_lg_),
+        m_size_(0),
+        m_chunks_(0),
+        m_fn_(0),
+        m_alloc_(node_allocator_traits::select_on_container_copy_construction(
+            sl.m_alloc_)),
+        m_it_(create_head()) {
+        append_unsafe(sl.begin(), sl.end());
+    }
+
+    self &operator=(const self &sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = sl.m_kov_;
+            m_c_ = sl.m_c_;
+            m_lg_ = sl.m_lg_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_copy_assignment::value) {
+                m_alloc_ = sl.m_alloc_;
+            }
+
+            append_unsafe(sl.begin(), sl.end());
+        }
+        return *this;
+    }
+
+    UnrolledSkipList(self &&sl) :
+        m_kov_(std::move(sl.m_kov_)),
+        m_c_(std::move(sl.m_c_)),
+        m_lg_(std::move(sl.m_lg_)),
+        m_size_(sl.m_size_),
+        m_chunks_(sl.m_chunks_),
+        m_fn_(sl.m_fn_),
+        m_alloc_(std::move(sl.m_alloc_)),
+        m_it_(sl.m_it_) {
+        sl.m_size_ = 0;
+        sl.m_chunks_ = 0;
+        sl.m_fn_ = 0;
+        sl.m_it_ = create_head();
+    }
+
+    self &operator=(self &&sl) {
+        if (this != &sl) {
+            clear();
+
+            m_kov_ = std::move(sl.m_kov_);
+            m_c_ = std::move(sl.m_c_);
+            m_lg_ = std::move(sl.m_lg_);
+            m_size_ = sl.m_size_;
+            m_chunks_ = sl.m_chunks_;
+            m_fn_ = sl.m_fn_;
+            if constexpr (node_allocator_traits::
+                          propagate_on_container_move_assignment::value) {
+                m_alloc_ = std::move(sl.m_alloc_);
+            }
+            destory_head(m_it_);
+            m_it_ = sl.m_it_;
+
+            sl.m_size_ = 0;
+            sl.m_chunks_ = 0;
+            sl.m_fn_ = 0;
+            sl.m_it_ = create_head();
+        }
+        return *this;
+    }
+
+    ~UnrolledSkipList() {
+        clear();
+        destory_head(m_it_);
+    }
+
+    iterator lower_bound(const key_type &key) const {
+        iterator it = chunk_search<false>(key);
+        if (it.is_head()) {
+            return begin();
+        }
+
+        pointer first = it.values();
+        pointer last = first + it.count();
+        pointer pos = std::lower_bound(first, last, key,
+            [this](const value_type &v, const key_type &k) {
+                return m_c_.less(m_kov_(v), k);
+            });
+        return make_iterator(it, pos - first);
+    }
+
+    iterator upper_bound(const key_type &key) const {
+        iterator it = chunk_search<true>(key);
+        if (it.is_head()) {
+            return begin();
+        }
+
+        pointer first = it.values();
+        pointer last = first + it.count();
+        pointer pos = std::upper_bound(first, last, key,
+            [this](const key_type &k, const value_type &v) {
+                return m_c_.less(k, m_kov_(v));
+            });
+        return make_iterator(it, pos - first);
+    }
+
+    /*
+     * 元素所在的槽位取决于它的键，而键要由构造出的元素得到，因此先在栈上
+     * 构造一次，再移入槽位
+     */
+    template <typename ... Args>
+    iterator emplace_equal(Args&& ... args) {
+        value_type value(std::forward<Args>(args)...);
+        return insert_equal(std::move(value));
+    }
+
+    iterator insert_equal(const value_type &value) {
+        return insert_unsafe(upper_bound(m_kov_(value)), value);
+    }
+
+    iterator insert_equal(value_type &&value) {
+        return insert_unsafe(upper_bound(m_kov_(value)), std::move(value));
+    }
+
+    template <typename Iterator>
+    void insert_equal(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_equal(*first++);
+        }
+    }
+
+    void insert_equal(std::initializer_list<value_type> ilist) {
+        insert_equal(ilist.begin(), ilist.end());
+    }
+
+    /*
+     * 同 emplace_equal，键已存在时返回 { iterator(), false }
+     */
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace_unique(Args&& ... args) {
+        value_type value(std::forward<Args>(args)...);
+        return insert_unique(std::move(value));
+    }
+
+    std::pair<iterator, bool> insert_unique(const value_type &value) {
+        iterator pos = lower_bound(m_kov_(value));
+        if (pos != end() && m_c_.equal(m_kov_(*pos), m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(pos, value), true };
+    }
+
+    std::pair<iterator, bool> insert_unique(value_type &&value) {
+        iterator pos = lower_bound(m_kov_(value));
+        if (pos != end() && m_c_.equal(m_kov_(*pos), m_kov_(value))) {
+            return { iterator(), false };
+        }
+        return { insert_unsafe(pos, std::move(value)), true };
+    }
+
+    template <typename Iterator>
+    void insert_unique(Iterator first, Iterator last) {
+        while (first != last) {
+            insert_unique(*first++);
+        }
+    }
+
+    void insert_unique(std::initializer_list<value_type> ilist) {
+        insert_unique(ilist.begin(), ilist.end());
+    }
+
+    /*
+     * 返回被删除元素之后的元素
+     */
+    iterator erase(iterator it) {
+        return erase_unsafe(it);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        size_type n = 0;
+        for (iterator it = first; it != last; ++it) {
+            ++n;
+        }
+        while (n--) {
+            first = erase_unsafe(first);
+        }
+        return first;
+    }
+
+    /*
+     * 删除所有与 key 相等的元素，返回其后的第一个元素
+     */
+    iterator erase(const key_type &key) {
+        iterator it = lower_bound(key);
+        while (it != end() && m_c_.equal(m_kov_(*it), key)) {
+            it = erase_unsafe(it);
+        }
+        return it;
+    }
+
+    /*
+     * [first, last) 必须有序，原有元素全部丢弃
+     */
+    template <typename Iterator>
+    void assign_sorted(Iterator first, Iterator last) {
+        clear();
+        append_unsafe(first, last);
+    }
+private:
+    /*
+     * 返回第一个元素在 key 之前的最后一个节点，没有则返回头节点
+     */
+    template <bool Upper>
+    iterator chunk_search(const key_type &key) const {
+        floor_number_type fn = m_fn_;
+        iterator it = end();
+        iterator next = it;
+        while (fn--) {
+            next = it.get_index_next(fn);
+            while (next != end() &&
+                   (Upper ? m_c_.less_or_equal(m_kov_(*next), key) :
+                    m_c_.less(m_kov_(*next), key))) {
+                it = next;
+                next = it.get_index_next(fn);
+            }
+        }
+        return it;
+    }
+
+    inline iterator make_iterator(iterator chunk, size_type index) const {
+        if (index < chunk.count()) {
+            return iterator(chunk.base(), index);
+        }
+        return chunk.get_index_next(0);
+    }
+
+    /*
+     * 在 pos 之前插入；pos 为 end() 时追加到最后一个节点
+     */
+    template <typename Arg>
+    iterator insert_unsafe(iterator pos, Arg &&value) {
+        if (pos.is_head()) {
+            pos = pos.get_index_prev(0);
+            if (pos.is_head()) {
+                pos = link_unsafe(end(), create_chunk());
+            } else {
+                pos.m_index_ = pos.count();
+            }
+        } else if (pos.m_index_ == 0 && !pos.get_index_prev(0).is_head() &&
+                   pos.get_index_prev(0).count() < CHUNK_CAPACITY) {
+            // 优先追加到前一个节点末尾，省去移动
+            pos = pos.get_index_prev(0);
+            pos.m_index_ = pos.count();
+        }
+
+        if constexpr (std::is_lvalue_reference<Arg>::value) {
+            /* value 引用本节点中的元素时，分裂与移动会使其失效，先复制出来 */
+            std::less<const value_type *> less;
+            const value_type *p = std::addressof(value);
+            if (!less(p, pos.values()) && less(p, pos.values() + pos.count())) {
+                return insert_unsafe(pos, value_type(value));
+            }
+        }
+
+        if (pos.count() == CHUNK_CAPACITY) {
+            constexpr size_type half = CHUNK_CAPACITY / 2;
+            iterator chunk = create_chunk();
+            pointer src = pos.values();
+            pointer dst = chunk.values();
+            std::uninitialized_move(src + half, src + CHUNK_CAPACITY, dst);
+            destory_values(src + half, src + CHUNK_CAPACITY);
+            chunk.to_node()->count = CHUNK_CAPACITY - half;
+            pos.to_node()->count = half;
+            link_unsafe(pos.get_index_next(0), chunk);
+
+            if (pos.m_index_ > half) {
+                chunk.m_index_ = pos.m_index_ - half;
+                pos = chunk;
+            }
+        }
+
+        pointer first = pos.values();
+        size_type n = pos.count();
+        size_type i = pos.m_index_;
+        if (i == n) {
+            ::new ((void *)(first + n)) value_type(std::forward<Arg>(value));
+        } else if constexpr (std::is_lvalue_reference<Arg>::value) {
+            /* 复制在移动元素之前完成，复制失败时节点保持不变 */
+            value_type tmp(value);
+            ::new ((void *)(first + n)) value_type(std::move(first[n - 1]));
+            std::move_backward(first + i, first + n - 1, first + n);
+            first[i] = std::move(tmp);
+        } else {
+            ::new ((void *)(first + n)) value_type(std::move(first[n - 1]));
+            std::move_backward(first + i, first + n - 1, first + n);
+            first[i] = std::move(value);
+        }
+        ++pos.to_node()->count;
+        ++m_size_;
+        return pos;
+    }
+
+    iterator erase_unsafe(iterator it) {
+        pointer first = it.values();
+        size_type n = it.count();
+        size_type i = it.m_index_;
+        std::move(first + i + 1, first + n, first + i);
+        destory_values(first + n - 1, first + n);
+        --it.to_node()->count;
+        --m_size_;
+
+        if (it.count() == 0) {
+            iterator next = it.get_index_next(0);
+            destory_chunk(unlink_unsafe(it));
+            return next;
+        }
+
+        if (it.count() < CHUNK_CAPACITY / 4) {
+            iterator next = it.get_index_next(0);
+            iterator prev = it.get_index_prev(0);
+            if (!next.is_head() && it.count() + next.count() <= CHUNK_CAPACITY * 3 / 4) {
+                merge_unsafe(it, next);
+            } else if (!prev.is_head() &&
+                       prev.count() + it.count() <= CHUNK_CAPACITY * 3 / 4) {
+                i += prev.count();
+                merge_unsafe(prev, it);
+                it = prev;
+            }
+        }
+        return make_iterator(it, i);
+    }
+
+    /*
+     * 把 next 中的元素移到 it 末尾并释放 next
+     */
+    void merge_unsafe(iterator it, iterator next) {
+        pointer src = next.values();
+        size_type n = next.count();
+        std::uninitialized_move(src, src + n, it.values() + it.count());
+        destory_values(src, src + n);
+        it.to_node()->count += n;
+        next.to_node()->count = 0;
+        destory_chunk(unlink_unsafe(next));
+    }
+
+    /*
+     * 把 it 链到 pos 之前，按 SkipList::insert_unsafe 的方式逐层向上寻找前驱
+     */
+    iterator link_unsafe(iterator pos, iterator it) {
+        floor_number_type itfn = it.floor_number();
+        floor_number_type posfn = pos.floor_number();
+        floor_number_type fn = 0;
+
+        m_fn_ = std::max(m_fn_, itfn);
+        while (fn < itfn) {
+            iterator ppos = pos.get_index_prev(fn);
+
+            it.set_prev_floor(fn, ppos);
+            it.set_next_floor(fn, pos);
+            ppos.set_next_floor(fn, it);
+            pos.set_prev_floor(fn, it);
+
+            ++fn;
+
+            while (fn < itfn && fn >= posfn) {
+                pos = pos.get_max_link();
+                posfn = pos.floor_number();
+            }
+        }
+        return it;
+    }
+
+    iterator unlink_unsafe(iterator it) {
+        floor_number_type fn = it.floor_number();
+        while (fn--) {
+            iterator prev = it.get_index_prev(fn);
+            iterator next = it.get_index_next(fn);
+            prev.set_next_floor(fn, next);
+            next.set_prev_floor(fn, prev);
+        }
+        while (m_fn_ > 0 && end().get_index_next(m_fn_ - 1) == end()) {
+            --m_fn_;
+        }
+        return it;
+    }
+
+    /*
+     * 以 3/4 的填充率顺序建表，为随后的插入留出空间
+     */
+    template <typename Iterator>
+    void append_unsafe(Iterator first, Iterator last) {
+        constexpr size_type fill = std::max<size_type>(1, CHUNK_CAPACITY * 3 / 4);
+        iterator chunk = end();
+        while (first != last) {
+            if (chunk.is_head() || chunk.count() == fill) {
+                chunk = link_unsafe(end(), create_chunk());
+            }
+            ::new ((void *)(chunk.values() + chunk.count())) value_type(*first++);
+            ++chunk.to_node()->count;
+            ++m_size_;
+        }
+    }
+private:
+    iterator create_head() {
+        std::allocator<skip_list_head> alloc;
+        skip_list_head *p = (skip_list_head *)malloc(
+            sizeof(skip_list_head) + MaxFloorNumber * sizeof(floor_type));
+        std::allocator_traits<std::allocator<skip_list_head>>().construct(
+            alloc, p, MaxFloorNumber);
+        return iterator(p);
+    }
+
+    iterator create_chunk() {
+        floor_number_type fn = floor_number();
+        skip_list_node *p = (skip_list_node *)node_allocator_traits::allocate(
+            m_alloc_, node_size(fn));
+        ::new ((void *)p) skip_list_node(fn);
+        ++m_chunks_;
+        return iterator(p);
+    }
+
+    void destory_head(iterator it) {
+        free(it.to_head());
+    }
+
+    void destory_chunk(iterator it) {
+        node_allocator_traits::deallocate(m_alloc_, (char *)it.to_node(),
+                                          node_size(it.floor_number()));
+        --m_chunks_;
+    }
+
+    inline static void destory_values(pointer first, pointer last) {
+        if constexpr (!std::is_trivially_destructible<value_type>::value) {
+            std::destroy(first, last);
+        }
+    }
+
+    void destory_all() {
+        constexpr bool release =
+            __detail::has_release<node_allocator_type>::value;
+        constexpr bool trivial =
+            std::is_trivially_destructible<value_type>::value;
+
+        if constexpr (!(release && trivial)) {
+            iterator it = begin();
+            while (it != end()) {
+                iterator tmp = it;
+                it = it.get_index_next(0);
+                destory_values(tmp.values(), tmp.values() + tmp.count());
+                if constexpr (!release) {
+                    node_allocator_traits::deallocate(
+                        m_alloc_, (char *)tmp.to_node(),
+                        node_size(tmp.floor_number()));
+                }
+            }
+        }
+        if constexpr (release) {
+            m_alloc_.release();
+        }
+
+        std::uninitialized_fill_n(m_it_.to_head()->floor, m_fn_,
+                                  floor_type{ m_it_.base(), m_it_.base() });
+        m_size_ = 0;
+        m_chunks_ = 0;
+        m_fn_ = 0;
+    }
+
+    inline static size_type node_size(floor_number_type fn) {
+        return sizeof(skip_list_node) + fn * sizeof(floor_type);
+    }
+
+    inline floor_number_type floor_number() {
+        return std::min<floor_number_type>(MaxFloorNumber, m_lg_());
+    }
+private:
+    key_of_value m_kov_;
+    comparer m_c_;
+    level_generator_type m_lg_;
+    size_type m_size_;
+    size_type m_chunks_;
+    floor_number_type m_fn_;
+    node_allocator_type m_alloc_;
+    iterator m_it_;
+};
+
+}
+
+#endif // _UNROLLED_SKIP_LIST_HPP__
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+TEST(allocator, case0) {
+    auto rv = bit::get_random_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::SkipList<bit::TestClass, bit::TestClass,
+            std::_Identity<bit::TestClass>, std::less<bit::TestClass>, 1> sls;
+
+        std::unordered_set<void *> ss;
+
+        for (const auto &i : rv) {
+            ss.emplace(sls.insert_equal(i).base());
+        }
+        ASSERT_EQ(ss.size(), rv.size());
+
+        auto it = sls.begin();
+        while (it != sls.end()) {
+            it = sls.erase(it);
+        }
+        ASSERT_TRUE(sls.empty());
+
+        for (const auto &i : rv) {
+            auto it = sls.insert_equal(i);
+            ASSERT_EQ(ss.count(it.base()), 1);
+        }
+        ASSERT_EQ(sls.size(), rv.size());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(allocator, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        ASSERT_EQ(sls.size(), rv.size());
+
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(sls.begin(), sls.end());
+
+        sls.insert_equal(rv.begin(), rv.end());
+        ASSERT_EQ(sls.size(), rv.size());
+
+        auto p = sls.begin();
+        auto q = sv.begin();
+        while (p != sls.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q++);
+        }
+    }
+
+    ASSERT_EQ(2 * rv.size(), bit::TestClass::copy_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(allocator, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::SkipList<bit::TestClass, bit::TestClass,
+            std::_Identity<bit::TestClass>, std::less<bit::TestClass>, 32,
+            std::allocator<bit::TestClass>> sls(rv.begin(), rv.end());
+        ASSERT_EQ(sls.size(), rv.size());
+
+        auto other = std::move(sls);
+        ASSERT_TRUE(sls.empty());
+
+        auto p = other.begin();
+        auto q = sv.begin();
+        while (p != other.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q++);
+        }
+
+        other.clear();
+        ASSERT_TRUE(other.empty());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+TEST(batch, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+        ASSERT_EQ(sv.size(), sls.insert_equal_batch(sv.begin(), sv.end()));
+        ASSERT_EQ(rv.size(), sls.insert_equal_batch(rv.begin(), rv.end()));
+        ASSERT_EQ(sls.size(), 2 * rv.size());
+
+        auto p = sls.begin();
+        auto q = sv.begin();
+        while (p != sls.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q);
+            ASSERT_EQ(*p++, *q++);
+        }
+        ASSERT_EQ(sls.end(), p);
+    }
+
+    ASSERT_EQ(0, bit::TestClass::init_ctor);
+    ASSERT_EQ(2 * rv.size(), bit::TestClass::copy_ctor);
+    ASSERT_EQ(0, bit::TestClass::move_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(batch, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_indexed_set<bit::TestClass> sls;
+        ASSERT_EQ(uv.size(), sls.insert_unique_batch(rv.begin(), rv.end()));
+        ASSERT_EQ(0, sls.insert_unique_batch(uv.begin(), uv.end()));
+        ASSERT_EQ(sls.size(), uv.size());
+
+        std::size_t i = 0;
+        for (auto it = sls.begin(); it != sls.end(); ++it, ++i) {
+            ASSERT_EQ(uv[i], *it);
+            ASSERT_EQ(it, sls.nth(i));
+            ASSERT_EQ(i, sls.rank(it));
+        }
+    }
+
+    ASSERT_EQ(uv.size(), bit::TestClass::copy_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(batch, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_indexed_set<bit::TestClass> sls(rv.begin(), rv.end());
+
+        bit::vec_t keys;
+        for (std::size_t i = 0; i < uv.size(); i += 2) {
+            keys.push_back(uv[i]);
+            keys.emplace_back(uv[i].value + 1);
+        }
+        std::size_t n = 0;
+        for (const auto &i : keys) {
+            n += std::count(sv.begin(), sv.end(), i);
+        }
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+        ASSERT_EQ(n, sls.erase_batch(keys.begin(), keys.end()));
+        ASSERT_EQ(rv.size() - n, sls.size());
+
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            ASSERT_EQ(i % 2 == 1, sls.contain(uv[i]));
+        }
+
+        std::size_t i = 0;
+        for (auto it = sls.begin(); it != sls.end(); ++it, ++i) {
+            ASSERT_EQ(it, sls.nth(i));
+        }
+
+        std::sort(keys.begin(), keys.end());
+        ASSERT_EQ(0, sls.erase_batch(keys.begin(), keys.end()));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
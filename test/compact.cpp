@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util.hpp"
+#include "compact_skip_list.hpp"
+
+template <typename T>
+using csl_set = bit::CompactSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename SL>
+static void check_lookup(const SL &sls, const bit::vec_t &v) {
+    bit::check_equal(sls, v);
+
+    for (const auto &i : v) {
+        ASSERT_EQ(i, *sls.lower_bound(i));
+    }
+}
+
+TEST(compact, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        csl_set<bit::TestClass> sls;
+        ASSERT_EQ(sls.end(), sls.begin());
+        ASSERT_EQ(sls.end(), sls.find(rv[0]));
+
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_lookup(sls, sv);
+
+        for (const auto &i : uv) {
+            for (int j = -1; j <= 1; ++j) {
+                auto tmpv = bit::TestClass(i.value + j);
+                auto lb = std::lower_bound(sv.begin(), sv.end(), tmpv);
+                auto ub = std::upper_bound(sv.begin(), sv.end(), tmpv);
+                ASSERT_EQ(ub - lb, sls.count(tmpv));
+                ASSERT_EQ(ub == sv.end(), sls.upper_bound(tmpv) == sls.end());
+            }
+            ASSERT_FALSE(sls.insert_unique(i).second);
+        }
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            auto n = std::count(sv.begin(), sv.end(), uv[i]);
+            if (i % 3 == 0) {
+                ASSERT_EQ(n, sls.erase(uv[i]));
+            } else if (i % 3 == 1) {
+                sls.erase(sls.find(uv[i]));
+                remain.insert(remain.end(), n - 1, uv[i]);
+            } else {
+                remain.insert(remain.end(), n, uv[i]);
+            }
+        }
+        check_lookup(sls, remain);
+
+        sls.erase(sls.begin(), sls.lower_bound(remain[remain.size() / 2]));
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(0, sls.height());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(compact, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        csl_set<bit::TestClass> sls;
+        for (const auto &i : rv) {
+            sls.emplace_unique(i.value);
+        }
+        check_lookup(sls, uv);
+
+        sls.assign_sorted(sv.begin(), sv.end());
+        check_lookup(sls, sv);
+
+        csl_set<bit::TestClass> other(sls);
+        check_lookup(other, sv);
+
+        csl_set<bit::TestClass> moved(std::move(other));
+        check_lookup(moved, sv);
+        ASSERT_TRUE(other.empty());
+        ASSERT_EQ(0, other.arena_bytes());
+
+        other = moved;
+        check_lookup(other, sv);
+        moved = std::move(sls);
+        check_lookup(moved, sv);
+
+        moved.clear();
+        ASSERT_EQ(0, moved.arena_bytes());
+        moved.insert_equal(rv.begin(), rv.end());
+        auto bytes = moved.arena_bytes();
+        moved.shrink_to_fit();
+        ASSERT_GE(bytes, moved.arena_bytes());
+        check_lookup(moved, sv);
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(compact, case2) {
+    /* 参数引用表中的元素，插入时节点池搬迁也不影响构造出的值 */
+    const std::string a(64, 'a'), b(64, 'b');
+    csl_set<std::string> sls;
+    sls.insert_equal(a);
+    std::size_t na = 1, nb = 0;
+    for (int i = 0; i < 4096; ++i) {
+        switch (i % 4) {
+        case 0:
+            sls.insert_equal(*sls.begin());
+            ++na;
+            break;
+        case 1:
+            sls.emplace_equal(*sls.rbegin());
+            ++(nb ? nb : na);
+            break;
+        case 2:
+            ASSERT_FALSE(sls.insert_unique(*sls.begin()).second);
+            ASSERT_FALSE(sls.emplace_unique(*sls.begin()).second);
+            sls.insert_equal(b);
+            ++nb;
+            break;
+        default:
+            sls.insert_equal(*sls.find(b));
+            ++nb;
+            break;
+        }
+    }
+
+    ASSERT_EQ(na + nb, sls.size());
+    ASSERT_EQ(na, sls.count(a));
+    ASSERT_EQ(nb, sls.count(b));
+}
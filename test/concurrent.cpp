@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util.hpp"
+#include "concurrent_skip_list.hpp"
+#include "lazy_skip_list.hpp"
+
+template <typename T>
+using csl_set = bit::ConcurrentSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename T>
+using lsl_set = bit::LazySkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+template <typename SL, typename T>
+static void check_content(const SL &sls, const std::vector<T> &v) {
+    ASSERT_EQ(v.size(), sls.size());
+
+    std::vector<T> content;
+    sls.for_each([&content](const T &i) {
+        content.push_back(i);
+    });
+    ASSERT_EQ(v, content);
+    auto guard = sls.pin();
+    for (const auto &i : v) {
+        ASSERT_NE(nullptr, sls.find(i, guard));
+        ASSERT_EQ(i, *sls.find(i, guard));
+    }
+}
+
+template <typename SL>
+static void test_sequential() {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        SL sls;
+        ASSERT_EQ(nullptr, sls.find(rv[0], sls.pin()));
+
+        for (const auto &i : rv) {
+            sls.insert_unique(i);
+        }
+        check_content(sls, uv);
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            ASSERT_FALSE(sls.emplace_unique(uv[i].value));
+            if (i % 2) {
+                ASSERT_TRUE(sls.erase(uv[i]));
+                ASSERT_FALSE(sls.erase(uv[i]));
+                ASSERT_FALSE(sls.contain(uv[i]));
+            } else {
+                remain.push_back(uv[i]);
+            }
+        }
+        check_content(sls, remain);
+
+        sls.reclaim();
+        check_content(sls, remain);
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(nullptr, sls.find(uv[0], sls.pin()));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(concurrent, case0) {
+    test_sequential<csl_set<bit::TestClass>>();
+    test_sequential<lsl_set<bit::TestClass>>();
+}
+
+template <typename SL>
+static void test_disjoint() {
+    constexpr int THREADS = 4;
+    constexpr int N = 4096;
+
+    SL sls;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&sls, t] {
+            for (int i = t; i < N; i += THREADS) {
+                sls.insert_unique(i);
+            }
+            for (int i = t; i < N; i += 2 * THREADS) {
+                sls.erase(i);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<int> remain;
+    for (int i = 0; i < N; ++i) {
+        if (i % (2 * THREADS) >= THREADS) {
+            remain.push_back(i);
+        }
+    }
+    check_content(sls, remain);
+}
+
+TEST(concurrent, case1) {
+    test_disjoint<csl_set<int>>();
+    test_disjoint<lsl_set<int>>();
+}
+
+template <typename SL>
+static void test_contended() {
+    constexpr int THREADS = 4;
+    constexpr int N = 256;
+    constexpr int ROUNDS = 20000;
+
+    SL sls;
+    std::vector<std::atomic<int>> balance(N);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&sls, &balance, t] {
+            std::default_random_engine dre(t);
+            std::uniform_int_distribution<int> uid(0, N - 1);
+            for (int r = 0; r < ROUNDS; ++r) {
+                int key = uid(dre);
+                if (r % 2) {
+                    balance[key] += sls.insert_unique(key);
+                } else {
+                    balance[key] -= sls.erase(key);
+                }
+                sls.contain(uid(dre));
+
+                /* 持有 guard 期间，找到的元素不会被并发的 erase 释放 */
+                key = uid(dre);
+                auto guard = sls.pin();
+                const int *p = sls.find(key, guard);
+                std::this_thread::yield();
+                if (p) {
+                    EXPECT_EQ(key, *p);
+                }
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<int> remain;
+    for (int i = 0; i < N; ++i) {
+        ASSERT_TRUE(balance[i] == 0 || balance[i] == 1);
+        if (balance[i]) {
+            remain.push_back(i);
+        }
+    }
+    check_content(sls, remain);
+}
+
+TEST(concurrent, case2) {
+    test_contended<csl_set<int>>();
+    test_contended<lsl_set<int>>();
+}
@@ -169,4 +169,126 @@ TEST(ctor, case4) {
     ASSERT_EQ(0, bit::TestClass::move_assign);
 
     ASSERT_TRUE(bit::TestClass::check());
-}
\ No newline at end of file
+}
+
+TEST(ctor, case5) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        sls.assign_sorted(sv.begin(), sv.end());
+
+        ASSERT_EQ(sls.size(), sv.size());
+        ASSERT_GT(sls.height(), 0);
+
+        auto p = sls.begin();
+        auto q = sv.begin();
+        while (p != sls.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q++);
+        }
+
+        for (const auto &i : uv) {
+            auto it = sls.lower_bound(i);
+            ASSERT_EQ(i, *it);
+            ASSERT_TRUE(it == sls.begin() || *(--it) < i);
+            ASSERT_EQ(sls.count(i), std::count(sv.begin(), sv.end(), i));
+        }
+
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(0, sls.height());
+    }
+
+    ASSERT_EQ(0, bit::TestClass::init_ctor);
+    ASSERT_EQ(2 * rv.size(), bit::TestClass::copy_ctor);
+    ASSERT_EQ(0, bit::TestClass::copy_assign);
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(ctor, case6) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        bit::sl_set<bit::TestClass> other;
+        other = sls;
+
+        ASSERT_EQ(sls.size(), other.size());
+
+        auto p = other.begin();
+        auto q = sv.begin();
+        while (p != other.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q++);
+        }
+
+        auto r = other.end();
+        for (auto it = sv.rbegin(); it != sv.rend(); ++it) {
+            ASSERT_EQ(*it, *(--r));
+        }
+        ASSERT_EQ(other.begin(), r);
+
+        for (const auto &i : rv) {
+            ASSERT_TRUE(other.contain(i));
+        }
+    }
+
+    ASSERT_EQ(2 * rv.size(), bit::TestClass::copy_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(ctor, case7) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        auto sls = bit::sl_set<bit::TestClass>::build_parallel(rv.begin(), rv.end(), 1);
+        ASSERT_EQ(sv.size(), sls.size());
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+        ASSERT_TRUE(std::equal(sv.rbegin(), sv.rend(), sls.rbegin(), sls.rend()));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+
+    using map_t = bit::sl_map<int, int>;
+    using indexed_t = bit::sl_indexed_set<int>;
+    constexpr int N = 5 * map_t::PARALLEL_CHUNK + 123;
+    std::default_random_engine dre;
+    std::uniform_int_distribution<int> uid(0, N / 8);
+    std::vector<std::pair<int, int>> pv;
+    std::vector<int> iv;
+    for (int i = 0; i < N; ++i) {
+        pv.emplace_back(uid(dre), i);
+        iv.push_back(pv.back().first);
+    }
+    std::vector<int> siv = iv;
+    std::sort(siv.begin(), siv.end());
+
+    for (std::size_t threads : { 2, 3, 8 }) {
+        /* 相等的键保持输入次序，与 insert_equal_batch 的结果一致 */
+        map_t expect;
+        expect.insert_equal_batch(pv.begin(), pv.end());
+        auto sls = map_t::build_parallel(pv.begin(), pv.end(), threads);
+        ASSERT_EQ(expect.size(), sls.size());
+        ASSERT_TRUE(std::equal(expect.begin(), expect.end(), sls.begin(), sls.end()));
+        ASSERT_TRUE(std::equal(expect.rbegin(), expect.rend(), sls.rbegin(), sls.rend()));
+        for (int i = 0; i < 64; ++i) {
+            int key = uid(dre);
+            ASSERT_EQ(expect.count(key), sls.count(key));
+        }
+        sls.insert_equal({ -1, -1 });
+        ASSERT_EQ(-1, sls.begin()->first);
+
+        auto ils = indexed_t::build_parallel(iv.begin(), iv.end(), threads);
+        for (std::size_t i = 0; i < siv.size(); i += 97) {
+            ASSERT_EQ(siv[i], *ils.nth(i));
+            ASSERT_EQ(i, ils.rank(ils.nth(i)));
+        }
+    }
+}
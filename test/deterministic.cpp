@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "util.hpp"
+#include "deterministic_skip_list.hpp"
+
+template <typename T, typename Allocator = bit::SkipListPool<T>>
+using dsl_set = bit::DeterministicSkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    Allocator>;
+
+template <typename SL>
+static void check_balanced(const SL &sls, const bit::vec_t &v) {
+    bit::check_equal(sls, v);
+
+    /* 每组至少 2 个元素，层数不超过 log2(n) + 1 */
+    if (!v.empty()) {
+        ASSERT_LE(sls.height(), std::log2(v.size()) + 1);
+    }
+}
+
+template <typename SL>
+static void test_insert_erase() {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        SL sls;
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_balanced(sls, sv);
+        bit::check_search(sls, sv, uv);
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            auto n = std::count(sv.begin(), sv.end(), uv[i]);
+            if (i % 3) {
+                ASSERT_EQ(n, sls.count(uv[i]));
+                auto it = sls.erase(uv[i]);
+                ASSERT_EQ(sls.upper_bound(uv[i]), it);
+                ASSERT_FALSE(sls.contain(uv[i]));
+            } else {
+                remain.insert(remain.end(), n, uv[i]);
+            }
+        }
+        check_balanced(sls, remain);
+        bit::check_search(sls, remain, uv);
+
+        while (!sls.empty()) {
+            sls.erase(sls.begin());
+        }
+        ASSERT_EQ(0, sls.height());
+
+        /* 删除后重新插入，表仍然平衡 */
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_balanced(sls, sv);
+        while (!sls.empty()) {
+            sls.erase(--sls.end());
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(deterministic, case0) {
+    test_insert_erase<dsl_set<bit::TestClass>>();
+    test_insert_erase<dsl_set<bit::TestClass, std::allocator<bit::TestClass>>>();
+}
+
+TEST(deterministic, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        dsl_set<bit::TestClass> sls;
+        for (const auto &i : rv) {
+            bool absent = sls.end() == sls.find(i);
+            ASSERT_EQ(absent, sls.insert_unique(i).second);
+        }
+        check_balanced(sls, uv);
+
+        auto first = sls.lower_bound(uv[uv.size() / 4]);
+        auto last = sls.lower_bound(uv[uv.size() / 2]);
+        auto it = sls.erase(first, last);
+        ASSERT_EQ(uv[uv.size() / 2], *it);
+
+        bit::vec_t remain(uv.begin(), uv.begin() + uv.size() / 4);
+        remain.insert(remain.end(), uv.begin() + uv.size() / 2, uv.end());
+        check_balanced(sls, remain);
+
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(deterministic, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        dsl_set<bit::TestClass> sls;
+        sls.assign_sorted(sv.begin(), sv.end());
+        check_balanced(sls, sv);
+        bit::check_search(sls, sv, uv);
+
+        dsl_set<bit::TestClass> other(sls);
+        check_balanced(other, sv);
+
+        dsl_set<bit::TestClass> moved(std::move(other));
+        check_balanced(moved, sv);
+        ASSERT_TRUE(other.empty());
+
+        other = moved;
+        check_balanced(other, sv);
+        moved = std::move(sls);
+        check_balanced(moved, sv);
+
+        moved.insert_equal(rv.begin(), rv.end());
+        ASSERT_EQ(2 * sv.size(), moved.size());
+        moved.clear();
+        ASSERT_TRUE(moved.empty());
+        ASSERT_EQ(moved.end(), moved.begin());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+/*
+ * 相等元素按插入顺序排列，从中间删除任意一个都不影响其他元素的位置
+ */
+TEST(deterministic, case3) {
+    using dsl_map = bit::DeterministicSkipList<int, std::pair<int, int>,
+        std::_Select1st<std::pair<int, int>>, std::less<int>>;
+
+    dsl_map sls;
+    std::vector<std::pair<int, int>> m;
+    std::vector<const std::pair<int, int> *> addrs;
+    for (int i = 0; i < 4096; ++i) {
+        auto it = sls.insert_equal({ i % 7, i });
+        m.push_back({ i % 7, i });
+        addrs.push_back(&*it);
+    }
+    std::stable_sort(m.begin(), m.end(), [](const auto &a, const auto &b) {
+        return a.first < b.first;
+    });
+    ASSERT_TRUE(std::equal(m.begin(), m.end(), sls.begin(), sls.end()));
+
+    std::mt19937 gen(0);
+    while (!m.empty()) {
+        std::size_t n = gen() % m.size();
+        auto it = sls.begin();
+        std::advance(it, n);
+        auto mit = m.begin() + n;
+        ASSERT_EQ(&*it, addrs[it->second]);
+
+        auto next = sls.erase(it);
+        mit = m.erase(mit);
+        ASSERT_EQ(mit == m.end(), next == sls.end());
+        if (mit != m.end()) {
+            ASSERT_EQ(*mit, *next);
+        }
+        if (m.size() % 64 == 0) {
+            ASSERT_TRUE(std::equal(m.begin(), m.end(), sls.begin(), sls.end()));
+            for (const auto &i : sls) {
+                ASSERT_EQ(&i, addrs[i.second]);
+            }
+        }
+    }
+    ASSERT_EQ(0, sls.height());
+}
+
+/*
+ * 与 SkipList 相同的接口：构造参数 p、带 hint 的插入与批量操作
+ */
+TEST(deterministic, case4) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        dsl_set<bit::TestClass> sls(rv.begin(), rv.end(), 0.25);
+        check_balanced(sls, sv);
+        ASSERT_EQ(dsl_set<bit::TestClass>::iterator(), sls.insert_unique(uv[0]).first);
+        ASSERT_FALSE(sls.emplace_unique(uv[0].value).second);
+
+        dsl_set<bit::TestClass> hinted;
+        auto hint = hinted.end();
+        for (const auto &i : sv) {
+            hint = hinted.insert_equal(hint, i);
+            ASSERT_EQ(i, *hint);
+            ++hint;
+        }
+        check_balanced(hinted, sv);
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            auto lb = hinted.lower_bound(uv[i]);
+            ASSERT_EQ(lb, hinted.lower_bound(lb, uv[i]));
+            ASSERT_EQ(lb, hinted.lower_bound(hinted.begin(), uv[i]));
+            ASSERT_FALSE(hinted.insert_unique(lb, uv[i]).second);
+            /* 元素直接在节点中构造，索引节点只拷贝键 */
+            auto moves = bit::TestClass::move_ctor;
+            ASSERT_EQ(uv[i], *hinted.emplace_hint_equal(hinted.begin(), uv[i].value));
+            ASSERT_EQ(moves, bit::TestClass::move_ctor);
+        }
+        ASSERT_EQ(sv.size() + uv.size(), hinted.size());
+        hinted.unique();
+        check_balanced(hinted, uv);
+
+        dsl_set<bit::TestClass> batch;
+        ASSERT_EQ(uv.size(), batch.insert_unique_batch(rv.begin(), rv.end()));
+        ASSERT_EQ(rv.size(), batch.insert_equal_batch(rv.begin(), rv.end()));
+        ASSERT_EQ(sv.size() + uv.size(), batch.size());
+        ASSERT_EQ(sv.size() + uv.size(), batch.erase_batch(uv.begin(), uv.end()));
+        ASSERT_TRUE(batch.empty());
+
+        std::vector<dsl_set<bit::TestClass>::iterator> found;
+        sls.find_many(uv.begin(), uv.end(), std::back_inserter(found));
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            ASSERT_EQ(uv[i], *found[i]);
+            ASSERT_EQ(sls.index_of(uv[i]), sls.rank(found[i]));
+            ASSERT_EQ(found[i], sls.nth(sls.rank(found[i])));
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
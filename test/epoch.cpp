@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util.hpp"
+#include "epoch.hpp"
+
+static void count_deleter(void *ctx, void *ptr) {
+    ++*(std::size_t *)ctx;
+    delete (int *)ptr;
+}
+
+TEST(epoch, case0) {
+    std::size_t freed = 0;
+    {
+        bit::EpochDomain domain;
+        auto guard = domain.pin();
+        auto nested = domain.pin();
+        for (int i = 0; i < 256; ++i) {
+            domain.retire(new int(i), count_deleter, &freed);
+        }
+        ASSERT_EQ(0, freed);
+
+        nested.reset();
+        for (int i = 0; i < 3; ++i) {
+            domain.collect();
+        }
+        ASSERT_EQ(0, freed);
+        ASSERT_EQ(256, domain.pending());
+
+        guard.reset();
+        for (int i = 0; i < 3; ++i) {
+            domain.collect();
+        }
+        ASSERT_EQ(256, freed);
+        ASSERT_EQ(0, domain.pending());
+
+        domain.retire(new int(0), count_deleter, &freed);
+        ASSERT_EQ(1, domain.pending());
+    }
+    ASSERT_EQ(257, freed);
+}
+
+TEST(epoch, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_published_set<bit::TestClass> sls(rv.begin(), rv.end());
+        sls.enable_epoch();
+        ASSERT_TRUE(sls.epoch_enabled());
+
+        auto guard = sls.pin();
+        auto it = sls.find(uv[0]);
+        sls.erase(it);
+        sls.erase(uv[1]);
+        ASSERT_EQ(uv[0], *it);
+        ASSERT_EQ(sv.size() - std::count(sv.begin(), sv.end(), uv[1]) - 1, sls.size());
+        ASSERT_EQ(sv.size() - sls.size(), sls.retired());
+
+        sls.reclaim();
+        ASSERT_EQ(sv.size() - sls.size(), sls.retired());
+        guard.reset();
+        for (int i = 0; i < 3; ++i) {
+            sls.reclaim();
+        }
+        ASSERT_EQ(0, sls.retired());
+
+        sls.erase(uv[2]);
+        auto copy(sls);
+        ASSERT_TRUE(copy.epoch_enabled());
+        ASSERT_EQ(0, copy.retired());
+        ASSERT_EQ(sls.size(), copy.size());
+
+        auto moved(std::move(sls));
+        ASSERT_EQ(0, moved.retired());
+        ASSERT_TRUE(moved.epoch_enabled());
+        ASSERT_FALSE(sls.epoch_enabled());
+
+        copy.erase(copy.begin(), copy.end());
+        copy.enable_epoch(false);
+        ASSERT_EQ(0, copy.retired());
+        moved.erase(uv[3]);
+        sls = std::move(moved);
+        ASSERT_TRUE(sls.epoch_enabled());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(epoch, case2) {
+    constexpr int READERS = 3;
+    constexpr int WRITES = 20000;
+
+    struct Cell {
+        int value;
+    };
+    auto deleter = [](void *, void *ptr) {
+        ((Cell *)ptr)->value = -1;
+        delete (Cell *)ptr;
+    };
+
+    bit::EpochDomain domain;
+    std::atomic<Cell *> shared(new Cell{0});
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                auto guard = domain.pin();
+                Cell *cell = shared.load(std::memory_order_acquire);
+                if (cell->value < 0) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (int i = 1; i <= WRITES; ++i) {
+        Cell *old = shared.exchange(new Cell{i}, std::memory_order_acq_rel);
+        domain.retire(old, deleter, nullptr);
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(0, failures.load());
+    /* 单核上被抢占的读者可能在整个写入期间都阻止 epoch 前进 */
+    for (int i = 0; i < 3; ++i) {
+        domain.collect();
+    }
+    ASSERT_EQ(0, domain.pending());
+    delete shared.load();
+}
@@ -113,4 +113,139 @@ TEST(clear, case0) {
 
         ASSERT_TRUE(sls.empty());
     }
-}
\ No newline at end of file
+}
+
+TEST(height, case0) {
+    auto rv = bit::get_random_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+        ASSERT_EQ(0, sls.height());
+
+        decltype(sls.height()) fn = 0;
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+            ASSERT_GE(sls.height(), fn);
+            fn = sls.height();
+        }
+        ASSERT_GT(sls.height(), 0);
+        ASSERT_LE(sls.height(), 32);
+
+        auto it = sls.begin();
+        while (it != sls.end()) {
+            it = sls.erase(it);
+            ASSERT_LE(sls.height(), fn);
+            fn = sls.height();
+        }
+        ASSERT_EQ(0, sls.height());
+
+        sls.insert_equal(rv.begin(), rv.end());
+        sls.clear();
+        ASSERT_EQ(0, sls.height());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(clear, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::SkipList<bit::TestClass, bit::TestClass,
+            std::_Identity<bit::TestClass>, std::less<bit::TestClass>, 32,
+            std::allocator<bit::TestClass>> sls(rv.begin(), rv.end());
+        ASSERT_EQ(sls.size(), rv.size());
+
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(0, sls.height());
+        ASSERT_EQ(sls.begin(), sls.end());
+        ASSERT_EQ(rv.size(), bit::TestClass::dtor);
+
+        sls.insert_equal(rv.begin(), rv.end());
+
+        auto p = sls.begin();
+        auto q = sv.begin();
+        while (p != sls.end() && q != sv.end()) {
+            ASSERT_EQ(*p++, *q++);
+        }
+    }
+
+    ASSERT_EQ(2 * rv.size(), bit::TestClass::dtor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(clear, case2) {
+    auto rv = bit::get_random_vector(1024);
+
+    {
+        bit::sl_set<int> sls;
+        for (const auto &i : rv) {
+            sls.insert_equal(i.value);
+        }
+        ASSERT_EQ(sls.size(), rv.size());
+
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(sls.end(), sls.find(rv[0].value));
+
+        for (const auto &i : rv) {
+            sls.insert_equal(i.value);
+        }
+        ASSERT_EQ(sls.size(), rv.size());
+        for (const auto &i : rv) {
+            ASSERT_TRUE(sls.contain(i.value));
+        }
+    }
+}
+
+TEST(erase, case3) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    for (int finger = 0; finger < 2; ++finger) {
+        for (std::size_t from : { 0ul, 100ul, 512ul }) {
+            for (std::size_t to : { 600ul, 1000ul, 1024ul }) {
+                bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+                sls.enable_finger(finger);
+
+                auto first = sls.begin();
+                std::advance(first, from);
+                auto last = first;
+                std::advance(last, to - from);
+
+                auto it = sls.erase(first, last);
+                ASSERT_EQ(last, it);
+                ASSERT_EQ(sls.size(), rv.size() - (to - from));
+
+                bit::vec_t tmp(sv.begin(), sv.begin() + from);
+                tmp.insert(tmp.end(), sv.begin() + to, sv.end());
+
+                auto p = sls.begin();
+                auto q = tmp.begin();
+                while (p != sls.end() && q != tmp.end()) {
+                    ASSERT_EQ(*p++, *q++);
+                }
+                ASSERT_EQ(sls.end(), p);
+
+                auto r = sls.end();
+                for (auto i = tmp.rbegin(); i != tmp.rend(); ++i) {
+                    ASSERT_EQ(*i, *(--r));
+                }
+
+                for (const auto &i : sv) {
+                    ASSERT_EQ(sls.count(i), std::count(tmp.begin(), tmp.end(), i));
+                }
+
+                sls.insert_equal(rv.begin(), rv.end());
+                ASSERT_EQ(sls.size(), 2 * rv.size() - (to - from));
+            }
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+TEST(finger, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        bit::sl_set<bit::TestClass> other(sls);
+        other.enable_finger();
+        ASSERT_TRUE(other.finger_enabled());
+
+        for (const auto &i : rv) {
+            for (int j = -1; j <= 1; ++j) {
+                auto tmpv = bit::TestClass(i.value + j);
+
+                auto p = sls.lower_bound(tmpv);
+                auto q = other.lower_bound(tmpv);
+                ASSERT_EQ(p == sls.end(), q == other.end());
+                ASSERT_TRUE(p == sls.end() || *p == *q);
+                ASSERT_TRUE(q == other.begin() || *(--q) < tmpv);
+
+                p = sls.upper_bound(tmpv);
+                q = other.upper_bound(tmpv);
+                ASSERT_EQ(p == sls.end(), q == other.end());
+                ASSERT_TRUE(p == sls.end() || *p == *q);
+                ASSERT_TRUE(q == other.begin() || !(tmpv < *(--q)));
+            }
+        }
+
+        ASSERT_EQ(other.begin(), other.lower_bound(bit::TestClass(INT32_MIN)));
+        ASSERT_EQ(other.end(), other.lower_bound(bit::TestClass(INT32_MAX)));
+        ASSERT_EQ(other.end(), other.upper_bound(bit::TestClass(INT32_MAX)));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(finger, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+        sls.enable_finger();
+
+        for (const auto &i : rv) {
+            auto it = sls.insert_equal(i);
+            ASSERT_EQ(i, *it);
+        }
+
+        for (std::size_t i = 0; i < uv.size(); i += 2) {
+            sls.erase(uv[i]);
+        }
+
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            ASSERT_EQ(i % 2 == 1, sls.contain(uv[i]));
+        }
+
+        auto prev = sls.begin();
+        for (auto it = sls.begin(); it != sls.end(); ++it) {
+            ASSERT_LE(prev->value, it->value);
+            prev = it;
+        }
+
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(sls.end(), sls.find(uv[0]));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(finger, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        sls.enable_finger();
+
+        for (const auto &i : uv) {
+            ASSERT_EQ(i, *sls.find(i));
+        }
+
+        const auto &stats = sls.finger_stats();
+        ASSERT_EQ(uv.size(), stats.searches);
+        ASSERT_GT(stats.reused, uv.size() * 3 / 4);
+        ASSERT_GT(stats.skipped_floors, stats.reused);
+
+        sls.reset_finger_stats();
+        ASSERT_EQ(0, sls.finger_stats().searches);
+
+        sls.enable_finger(false);
+        ASSERT_FALSE(sls.finger_enabled());
+        for (const auto &i : uv) {
+            ASSERT_EQ(i, *sls.find(i));
+        }
+        ASSERT_EQ(0, sls.finger_stats().searches);
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
@@ -7,6 +7,8 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 
 #include "skip_list.hpp"
 
@@ -15,6 +17,14 @@ namespace bit {
 template <typename T>
 using sl_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>>;
 
+template <typename T>
+using sl_indexed_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, bit::IndexedLinkPolicy>;
+
+template <typename T, typename LinkPolicy = bit::PublishedLinkPolicy>
+using sl_published_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, LinkPolicy>;
+
 template <typename K, typename V>
 using sl_map = bit::SkipList<K, std::pair<K, V>,
     std::_Select1st<std::pair<K, V>>, std::less<K>>;
@@ -161,6 +171,64 @@ inline void reset(std::size_t size) {
     RandomTestVector::getInstance(size) = RandomTestVector(size, ++um[size]);
 }
 
+/*
+ * 依次比较 sls 与有序区间 [first, last) 的元素，迭代器可以反向移动时
+ * 再从尾部反向比较一次
+ */
+template <typename SL, typename Iterator>
+inline void check_equal(const SL &sls, Iterator first, Iterator last) {
+    using category = typename std::iterator_traits<typename SL::iterator>::iterator_category;
+
+    ASSERT_EQ((std::size_t)std::distance(first, last), sls.size());
+
+    auto p = sls.begin();
+    for (auto i = first; i != last; ++i) {
+        ASSERT_NE(sls.end(), p);
+        ASSERT_EQ(*i, *p++);
+    }
+    ASSERT_EQ(sls.end(), p);
+
+    if constexpr (std::is_base_of_v<std::bidirectional_iterator_tag, category>) {
+        for (auto i = last; i != first;) {
+            ASSERT_EQ(*--i, *--p);
+        }
+        ASSERT_EQ(sls.begin(), p);
+    }
+}
+
+template <typename SL>
+inline void check_equal(const SL &sls, const vec_t &v) {
+    check_equal(sls, v.begin(), v.end());
+}
+
+/*
+ * sv 为 sls 中元素排序后的结果，对 uv 中每个键及其相邻的键比较各种查找的结果
+ */
+template <typename SL>
+inline void check_search(const SL &sls, const vec_t &sv, const vec_t &uv) {
+    for (const auto &i : uv) {
+        for (int j = -1; j <= 1; ++j) {
+            auto tmpv = TestClass(i.value + j);
+            auto lb = std::lower_bound(sv.begin(), sv.end(), tmpv);
+            auto ub = std::upper_bound(sv.begin(), sv.end(), tmpv);
+
+            auto slb = sls.lower_bound(tmpv);
+            auto sub = sls.upper_bound(tmpv);
+            ASSERT_EQ(lb == sv.end(), slb == sls.end());
+            ASSERT_EQ(ub == sv.end(), sub == sls.end());
+            if (lb != sv.end()) {
+                ASSERT_EQ(*lb, *slb);
+            }
+            if (ub != sv.end()) {
+                ASSERT_EQ(*ub, *sub);
+            }
+            ASSERT_EQ(ub - lb, sls.count(tmpv));
+            ASSERT_EQ(ub != lb, sls.contain(tmpv));
+            ASSERT_EQ(ub != lb, sls.find(tmpv) != sls.end());
+        }
+    }
+}
+
 }
 
 #endif // _UTIL_HPP__
\ No newline at end of file
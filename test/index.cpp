@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+template <typename SL>
+static void check_index(const SL &sls) {
+    std::size_t i = 0;
+    for (auto it = sls.begin(); it != sls.end(); ++it, ++i) {
+        ASSERT_EQ(it, sls.nth(i));
+        ASSERT_EQ(i, sls.rank(it));
+    }
+    ASSERT_EQ(sls.size(), i);
+    ASSERT_EQ(sls.end(), sls.nth(i));
+    ASSERT_EQ(sls.size(), sls.rank(sls.end()));
+}
+
+TEST(index, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_indexed_set<bit::TestClass> sls;
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_index(sls);
+
+        for (const auto &i : uv) {
+            for (int j = -1; j <= 1; ++j) {
+                auto tmpv = bit::TestClass(i.value + j);
+                auto lb = std::lower_bound(sv.begin(), sv.end(), tmpv);
+                auto ub = std::upper_bound(sv.begin(), sv.end(), tmpv);
+
+                ASSERT_EQ(lb - sv.begin(), sls.index_of(tmpv));
+                ASSERT_EQ(ub - lb, sls.count(tmpv));
+
+                auto er = sls.equal_range(tmpv);
+                ASSERT_EQ(ub - lb, sls.distance(er.first, er.second));
+                ASSERT_EQ(lb - ub, sls.distance(er.second, er.first));
+            }
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(index, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_indexed_set<bit::TestClass> sls;
+        sls.assign_sorted(sv.begin(), sv.end());
+        check_index(sls);
+
+        bit::sl_indexed_set<bit::TestClass> other(sls);
+        check_index(other);
+
+        for (std::size_t i = 0; i < uv.size(); i += 3) {
+            sls.erase(uv[i]);
+        }
+        check_index(sls);
+
+        auto first = sls.nth(sls.size() / 4);
+        auto last = sls.nth(sls.size() / 2);
+        sls.erase(first, last);
+        check_index(sls);
+
+        sls.erase(sls.nth(0));
+        sls.erase(sls.nth(sls.size() - 1));
+        check_index(sls);
+
+        auto hint = sls.end();
+        for (const auto &i : rv) {
+            hint = sls.insert_equal(hint, i);
+        }
+        check_index(sls);
+
+        sls.unique();
+        ASSERT_EQ(sls.size(), uv.size());
+        check_index(sls);
+
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+        check_index(sls);
+
+        for (const auto &i : rv) {
+            sls.insert_unique(i);
+        }
+        check_index(sls);
+
+        sls.clear();
+        sls.insert_equal(rv.begin(), rv.end());
+        check_index(sls);
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(index, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+        check_index(sls);
+
+        for (std::size_t i = 0; i < sv.size(); i += 7) {
+            ASSERT_EQ(sv[i], *sls.nth(i));
+            ASSERT_EQ(std::lower_bound(sv.begin(), sv.end(), sv[i]) - sv.begin(),
+                      sls.index_of(sv[i]));
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
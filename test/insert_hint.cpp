@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+TEST(insert_hint, case0) {
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+
+        for (const auto &i : sv) {
+            auto it = sls.insert_equal(sls.end(), i);
+            ASSERT_EQ(i, *it);
+        }
+
+        ASSERT_EQ(sls.size(), sv.size());
+
+        auto slit = sls.begin();
+        auto svit = sv.begin();
+        while (slit != sls.end() && svit != sv.end()) {
+            ASSERT_EQ(*slit++, *svit++);
+        }
+    }
+
+    ASSERT_EQ(0, bit::TestClass::init_ctor);
+    ASSERT_EQ(sv.size(), bit::TestClass::copy_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(insert_hint, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+
+        std::unordered_set<void *> ss;
+        auto hint = sls.end();
+
+        for (const auto &i : rv) {
+            auto it = sls.insert_equal(hint, i);
+            ASSERT_EQ(ss.count(it.base()), 0);
+            ASSERT_EQ(i, *it);
+            ss.emplace(it.base());
+            hint = (i.value & 1) ? it : sls.begin();
+        }
+
+        ASSERT_EQ(sls.size(), rv.size());
+
+        auto slit = sls.begin();
+        auto svit = sv.begin();
+        while (slit != sls.end() && svit != sv.end()) {
+            ASSERT_EQ(*slit++, *svit++);
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(insert_hint, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+
+        auto hint = sls.end();
+        for (const auto &i : rv) {
+            auto p = sls.insert_unique(hint, i);
+            if (p.second) {
+                ASSERT_EQ(i, *p.first);
+                hint = p.first;
+            }
+        }
+
+        ASSERT_EQ(sls.size(), uv.size());
+
+        for (const auto &i : rv) {
+            auto p = sls.emplace_hint_unique(sls.begin(), i.value);
+            ASSERT_FALSE(p.second);
+        }
+
+        ASSERT_EQ(sls.size(), uv.size());
+
+        auto slit = sls.begin();
+        auto uvit = uv.begin();
+        while (slit != sls.end() && uvit != uv.end()) {
+            ASSERT_EQ(*slit++, *uvit++);
+        }
+    }
+
+    ASSERT_EQ(rv.size(), bit::TestClass::init_ctor);
+    ASSERT_EQ(uv.size(), bit::TestClass::copy_ctor);
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(lower_bound, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+
+        std::vector<bit::sl_set<bit::TestClass>::iterator> hints{
+            sls.begin(), sls.end(), bit::sl_set<bit::TestClass>::iterator() };
+        for (auto it = sls.begin(); it != sls.end(); ++it) {
+            if (it->value % 97 == 0) {
+                hints.push_back(it);
+            }
+        }
+
+        for (const auto &hint : hints) {
+            for (const auto &i : uv) {
+                for (int j = -1; j <= 1; ++j) {
+                    auto tmpv = bit::TestClass(i.value + j);
+                    ASSERT_EQ(sls.lower_bound(tmpv), sls.lower_bound(hint, tmpv));
+                }
+            }
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
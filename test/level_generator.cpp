@@ -0,0 +1,217 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util.hpp"
+#include "unrolled_skip_list.hpp"
+#include "compact_skip_list.hpp"
+#include "concurrent_skip_list.hpp"
+#include "lazy_skip_list.hpp"
+
+template <typename T, typename LevelGenerator>
+using sl_generator_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, bit::DefaultLinkPolicy, LevelGenerator>;
+
+/*
+ * 塔高不小于 h 的比例应接近 p^(h - 1)
+ */
+template <typename LevelGenerator>
+static void test_distribution(double p) {
+    constexpr int N = 1 << 20;
+    constexpr int H = 8;
+
+    LevelGenerator lg(p);
+    std::vector<int> count(H + 1);
+    for (int i = 0; i < N; ++i) {
+        unsigned h = lg();
+        ASSERT_LE(1, h);
+        ++count[std::min<unsigned>(h, H)];
+    }
+
+    int above = N;
+    double expected = N;
+    for (int h = 1; h <= H; ++h) {
+        ASSERT_NEAR(1.0, above / expected, 0.05 + 0.05 * h);
+        above -= count[h];
+        expected *= p;
+    }
+}
+
+TEST(level_generator, case0) {
+    test_distribution<bit::XorshiftLevelGenerator<>>(0.5);
+    test_distribution<bit::XorshiftLevelGenerator<2>>(0.25);
+    test_distribution<bit::XorshiftLevelGenerator<>>(0.3);
+    test_distribution<bit::SeededLevelGenerator<>>(0.5);
+    test_distribution<bit::SeededLevelGenerator<2>>(0.5);
+    test_distribution<bit::GeometricLevelGenerator>(0.5);
+    test_distribution<bit::GeometricLevelGenerator>(0.3);
+
+    ASSERT_THROW(bit::XorshiftLevelGenerator<>(1.0), std::invalid_argument);
+    ASSERT_THROW(bit::SeededLevelGenerator<>(-0.5), std::invalid_argument);
+    sl_generator_set<int, bit::XorshiftLevelGenerator<2>> sls;
+    ASSERT_EQ(0.25, sls.default_probability);
+}
+
+TEST(level_generator, case1) {
+    /* 固定种子的序列可复现，重新播种后序列改变 */
+    bit::SeededLevelGenerator<> a, b;
+    std::vector<unsigned> sa, sb;
+    for (int i = 0; i < 1024; ++i) {
+        sa.push_back(a());
+        sb.push_back(b());
+    }
+    ASSERT_EQ(sa, sb);
+
+    auto fa = a.fork(), fb = b.fork();
+    for (int i = 0; i < 1024; ++i) {
+        ASSERT_EQ(fa(), fb());
+        ASSERT_EQ(a(), b());
+    }
+
+    b.seed(42);
+    bool differ = false;
+    for (int i = 0; i < 1024; ++i) {
+        differ |= a() != b();
+    }
+    ASSERT_TRUE(differ);
+
+    /* 默认生成器的种子各不相同 */
+    bit::XorshiftLevelGenerator<> x, y;
+    differ = false;
+    for (int i = 0; i < 1024; ++i) {
+        differ |= x() != y();
+    }
+    ASSERT_TRUE(differ);
+}
+
+template <typename LevelGenerator>
+static void test_skip_list(double p) {
+    using SL = sl_generator_set<bit::TestClass, LevelGenerator>;
+    auto rv = bit::get_random_vector(4096);
+    auto sv = bit::get_sorted_vector(4096);
+    bit::TestClass::reset();
+
+    {
+        SL sls(rv.begin(), rv.end(), p);
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+
+        auto upper = sls.split(sv[sv.size() / 2]);
+        sls.join(upper);
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+
+        SL copy(sls);
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), copy.begin(), copy.end()));
+
+        for (const auto &i : rv) {
+            sls.erase(i);
+        }
+        ASSERT_TRUE(sls.empty());
+
+        auto built = SL::build_parallel(rv.begin(), rv.end(), 4, p);
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), built.begin(), built.end()));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(level_generator, case2) {
+    test_skip_list<bit::XorshiftLevelGenerator<>>(0.5);
+    test_skip_list<bit::XorshiftLevelGenerator<2>>(0.25);
+    test_skip_list<bit::XorshiftLevelGenerator<>>(0.25);
+    test_skip_list<bit::SeededLevelGenerator<>>(0.5);
+    test_skip_list<bit::GeometricLevelGenerator>(0.25);
+
+    /* 默认生成器接受任意的运行期 p */
+    auto rv = bit::get_random_vector(4096);
+    auto sv = bit::get_sorted_vector(4096);
+    bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end(), 0.25);
+    ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+    ASSERT_GE(14, sls.height());
+}
+
+TEST(level_generator, case3) {
+    using SL = sl_generator_set<int, bit::SeededLevelGenerator<>>;
+    std::vector<int> v(1 << 16);
+    std::mt19937 gen(0);
+    for (auto &i : v) {
+        i = (int)(gen() >> 1) - (1 << 30);
+    }
+
+    /* 同样的插入序列得到同样的塔高 */
+    SL a, b;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        a.insert_equal(v[i]);
+        b.insert_equal(v[i]);
+        ASSERT_EQ(a.height(), b.height());
+    }
+
+    a.level_generator().seed(7);
+    b.level_generator().seed(7);
+    auto ua = a.split(0), ub = b.split(0);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        ua.insert_equal(v[i]);
+        ub.insert_equal(v[i]);
+        ASSERT_EQ(ua.height(), ub.height());
+    }
+
+    auto pa = SL::build_parallel(v.begin(), v.end(), 4);
+    auto pb = SL::build_parallel(v.begin(), v.end(), 4);
+    ASSERT_EQ(pa.height(), pb.height());
+}
+
+template <typename SL>
+static void test_container(double p) {
+    auto rv = bit::get_random_vector(4096);
+    auto sv = bit::get_sorted_vector(4096);
+
+    SL sls(rv.begin(), rv.end(), p);
+    ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+}
+
+/*
+ * 每个线程从表的生成器 fork() 出自己的生成器，多个表交替插入时各自的
+ * 生成器互不影响
+ */
+template <typename SL>
+static void test_concurrent(double p) {
+    constexpr int THREADS = 4;
+    constexpr int N = 1 << 12;
+
+    SL a(p), b;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = t; i < N; i += THREADS) {
+                a.insert_unique(i);
+                b.insert_unique(-i);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<int> va, vb;
+    a.for_each([&](int i) { va.push_back(i); });
+    b.for_each([&](int i) { vb.push_back(-i); });
+    ASSERT_EQ((std::size_t)N, va.size());
+    ASSERT_TRUE(std::is_sorted(va.begin(), va.end()));
+    std::reverse(vb.begin(), vb.end());
+    ASSERT_EQ(va, vb);
+}
+
+TEST(level_generator, case4) {
+    using T = bit::TestClass;
+    test_container<bit::UnrolledSkipList<T, T, std::_Identity<T>, std::less<T>, 32, 256,
+        bit::SkipListPool<T>, bit::GeometricLevelGenerator>>(0.25);
+    test_container<bit::UnrolledSkipList<T, T, std::_Identity<T>, std::less<T>>>(0.25);
+    test_container<bit::CompactSkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+        bit::SeededLevelGenerator<2>>>(0.25);
+    test_container<bit::CompactSkipList<T, T, std::_Identity<T>, std::less<T>>>(0.25);
+
+    test_concurrent<bit::ConcurrentSkipList<int, int, std::_Identity<int>, std::less<int>>>(0.25);
+    test_concurrent<bit::ConcurrentSkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+        bit::GeometricLevelGenerator>>(0.25);
+    test_concurrent<bit::LazySkipList<int, int, std::_Identity<int>, std::less<int>, 32,
+        bit::SeededLevelGenerator<>>>(0.5);
+}
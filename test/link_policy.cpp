@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+template <typename T, typename LinkPolicy>
+using sl_policy_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, LinkPolicy>;
+
+template <typename SL>
+static void check_lookup(const SL &sls, const bit::vec_t &v) {
+    bit::check_equal(sls, v);
+
+    for (const auto &i : v) {
+        ASSERT_EQ(i, *sls.lower_bound(i));
+    }
+}
+
+template <typename SL>
+static void test_insert_erase(bool finger) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        SL sls;
+        sls.enable_finger(finger);
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_lookup(sls, sv);
+
+        for (const auto &i : uv) {
+            ASSERT_EQ(std::count(sv.begin(), sv.end(), i), sls.count(i));
+            ASSERT_FALSE(sls.insert_unique(i).second);
+        }
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            if (i % 3 == 0) {
+                sls.erase(uv[i]);
+            } else if (i % 3 == 1) {
+                sls.erase(sls.find(uv[i]));
+                remain.insert(remain.end(), std::count(sv.begin(), sv.end(), uv[i]) - 1,
+                              uv[i]);
+            } else {
+                remain.insert(remain.end(), std::count(sv.begin(), sv.end(), uv[i]),
+                              uv[i]);
+            }
+        }
+        check_lookup(sls, remain);
+
+        sls.unique();
+        remain.erase(std::unique(remain.begin(), remain.end()), remain.end());
+        check_lookup(sls, remain);
+
+        for (const auto &i : remain) {
+            ASSERT_EQ(i, *sls.insert_equal(sls.find(i), i));
+        }
+        auto hint = sls.begin();
+        for (const auto &i : remain) {
+            hint = sls.insert_equal(hint, i);
+            ASSERT_EQ(i, *hint);
+        }
+        bit::vec_t tripled;
+        for (const auto &i : remain) {
+            tripled.insert(tripled.end(), 3, i);
+        }
+        check_lookup(sls, tripled);
+
+        sls.erase(sls.begin(), sls.find(remain[remain.size() / 2]));
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(0, sls.height());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(link_policy, case0) {
+    test_insert_erase<sl_policy_set<bit::TestClass, bit::BottomBackwardLinkPolicy>>(false);
+    test_insert_erase<sl_policy_set<bit::TestClass, bit::BottomBackwardLinkPolicy>>(true);
+    test_insert_erase<sl_policy_set<bit::TestClass, bit::ForwardLinkPolicy>>(false);
+    test_insert_erase<sl_policy_set<bit::TestClass, bit::ForwardLinkPolicy>>(true);
+}
+
+TEST(link_policy, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        sl_policy_set<bit::TestClass, bit::ForwardLinkPolicy> sls;
+        sls.assign_sorted(sv.begin(), sv.end());
+        check_lookup(sls, sv);
+
+        auto other(sls);
+        ASSERT_EQ(uv.size(), other.insert_unique_batch(rv.begin(), rv.end()) + uv.size());
+        ASSERT_EQ(rv.size(), other.insert_equal_batch(rv.begin(), rv.end()));
+        ASSERT_EQ(2 * rv.size(), other.erase_batch(uv.begin(), uv.end()));
+        ASSERT_TRUE(other.empty());
+
+        sl_policy_set<bit::TestClass, bit::BottomBackwardLinkPolicy> bls(rv.begin(), rv.end());
+        bls.insert_equal(sv.begin(), sv.end());
+        ASSERT_EQ(2 * sv.size(), bls.erase_batch(uv.begin(), uv.end()));
+        bls.assign_sorted(sv.begin(), sv.end());
+        check_lookup(bls, sv);
+        ASSERT_EQ(sv.back(), bls.back());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <thread>
+
+#include "util.hpp"
+#include "mvcc_skip_list.hpp"
+
+template <typename K, typename V>
+using mvcc_map = bit::MvccSkipList<K, std::pair<K, V>,
+    std::_Select1st<std::pair<K, V>>, std::less<K>>;
+
+template <typename T>
+using mvcc_set = bit::MvccSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+TEST(mvcc, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        mvcc_set<bit::TestClass> sls;
+        for (const auto &i : rv) {
+            sls.insert_unique(i);
+        }
+        ASSERT_EQ(uv.size(), sls.size());
+
+        auto before = sls.snapshot();
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            if (i % 2) {
+                ASSERT_TRUE(sls.erase(uv[i]));
+                ASSERT_FALSE(sls.erase(uv[i]));
+            } else {
+                ASSERT_FALSE(sls.insert_unique(uv[i]));
+                ASSERT_FALSE(sls.insert_or_assign(uv[i]));
+                remain.push_back(uv[i]);
+            }
+        }
+        auto after = sls.snapshot();
+        ASSERT_EQ(remain.size(), sls.size());
+        ASSERT_LT(before.sequence(), after.sequence());
+
+        /* 快照只看到创建时的版本 */
+        ASSERT_TRUE(std::equal(uv.begin(), uv.end(), before.begin(), before.end()));
+        ASSERT_TRUE(std::equal(remain.begin(), remain.end(), after.begin(), after.end()));
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            ASSERT_TRUE(before.contain(uv[i]));
+            ASSERT_EQ(i % 2 == 0, after.contain(uv[i]));
+            auto lb = after.lower_bound(uv[i]);
+            if ((i + 1) / 2 < remain.size()) {
+                ASSERT_EQ(remain[(i + 1) / 2], *lb);
+            } else {
+                ASSERT_EQ(after.end(), lb);
+            }
+            auto ub = before.upper_bound(uv[i]);
+            if (i + 1 < uv.size()) {
+                ASSERT_EQ(uv[i + 1], *ub);
+            } else {
+                ASSERT_EQ(before.end(), ub);
+            }
+        }
+
+        /* 快照仍然存在时旧版本不能回收 */
+        sls.gc();
+        ASSERT_EQ(uv.size() * 2, sls.versions());
+        {
+            auto tmp = std::move(before);
+        }
+        sls.gc();
+        ASSERT_EQ(remain.size(), sls.versions());
+        {
+            auto tmp = std::move(after);
+            ASSERT_TRUE(std::equal(remain.begin(), remain.end(), tmp.begin(), tmp.end()));
+        }
+
+        /* 没有快照时每次写入顺带截下旧版本 */
+        for (const auto &i : uv) {
+            sls.insert_or_assign(i);
+        }
+        ASSERT_EQ(uv.size(), sls.size());
+        ASSERT_EQ(uv.size(), sls.versions());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+/*
+ * 写者按确定的顺序修改，读者由快照的序号重放出应有的内容并与快照比较
+ */
+TEST(mvcc, case1) {
+    constexpr int READERS = 3;
+    constexpr int KEYS = 64;
+    constexpr int N = 1 << 14;
+
+    /* 删除不存在的键不产生新的序号 */
+    auto replay = [](std::uint64_t seq) {
+        std::map<int, int> m;
+        for (int i = 0; seq; ++i) {
+            if (i % 3 != 2) {
+                m[i % KEYS] = i;
+                --seq;
+            } else if (m.erase(i % KEYS)) {
+                --seq;
+            }
+        }
+        return m;
+    };
+
+    mvcc_map<int, int> sls;
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                auto snapshot = sls.snapshot();
+                std::vector<std::pair<int, int>> content(snapshot.begin(), snapshot.end());
+                /* 扫描期间写者继续修改，快照的内容不变 */
+                std::this_thread::yield();
+                for (const auto &i : snapshot) {
+                    content.push_back(i);
+                }
+
+                auto m = replay(snapshot.sequence());
+                std::vector<std::pair<int, int>> expected(m.begin(), m.end());
+                expected.insert(expected.end(), m.begin(), m.end());
+                if (content != expected) {
+                    ++failures;
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < N; ++i) {
+        if (i % 3 == 2) {
+            sls.erase(i % KEYS);
+        } else {
+            sls.insert_or_assign({ i % KEYS, i });
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : readers) {
+        t.join();
+    }
+    ASSERT_EQ(0, failures.load());
+
+    sls.gc();
+    ASSERT_EQ(replay(sls.sequence()).size(), sls.size());
+    ASSERT_EQ(sls.size(), sls.versions());
+}
+
+/*
+ * 快照交给另一个线程使用与析构；读者扫描期间写者摘除它跳过的条目
+ */
+TEST(mvcc, case2) {
+    constexpr int N = 1 << 12;
+
+    mvcc_set<int> sls;
+    for (int i = 0; i < N; ++i) {
+        sls.insert_unique(i);
+    }
+    std::optional<decltype(sls.snapshot())> old(sls.snapshot());
+    for (int i = 1; i < N; i += 2) {
+        sls.erase(i);
+    }
+
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::thread reader([&, snapshot = sls.snapshot()] {
+        for (int round = 0; round < 64; ++round) {
+            int expected = 0;
+            for (auto it = snapshot.begin(); it != snapshot.end(); ++it) {
+                if (*it != expected) {
+                    ++failures;
+                }
+                expected += 2;
+                if (*it % 256 == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            if (expected != N || snapshot.contain(1) || !snapshot.contain(N - 2)) {
+                ++failures;
+            }
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    old.reset();
+    for (int i = N; !done.load(std::memory_order_acquire); ++i) {
+        sls.insert_unique(i);
+        sls.erase(i);
+        sls.gc();
+    }
+    reader.join();
+
+    ASSERT_EQ(0, failures.load());
+    sls.gc();
+    ASSERT_EQ((std::size_t)N / 2, sls.size());
+    ASSERT_EQ(sls.size(), sls.versions());
+}
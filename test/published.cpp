@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "util.hpp"
+
+struct BottomPublishedLinkPolicy : public bit::BottomBackwardLinkPolicy {
+    constexpr static bool published = true;
+};
+
+TEST(published, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_published_set<bit::TestClass> sls(rv.begin(), rv.end());
+        ASSERT_TRUE(std::equal(sv.begin(), sv.end(), sls.begin(), sls.end()));
+        ASSERT_TRUE(std::equal(sv.rbegin(), sv.rend(), sls.rbegin(), sls.rend()));
+        for (const auto &i : uv) {
+            ASSERT_EQ(std::count(sv.begin(), sv.end(), i), sls.count(i));
+            sls.erase(i);
+        }
+        ASSERT_TRUE(sls.empty());
+
+        bit::sl_published_set<bit::TestClass, BottomPublishedLinkPolicy> bls;
+        bls.insert_equal(rv.begin(), rv.end());
+        ASSERT_TRUE(std::equal(sv.rbegin(), sv.rend(), bls.rbegin(), bls.rend()));
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+template <typename SL>
+static void test_concurrent_readers() {
+    constexpr int READERS = 3;
+    constexpr int N = 1 << 14;
+
+    std::vector<int> keys(N);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+
+    SL sls;
+    std::atomic<int> inserted(0);
+    std::atomic<int> failures(0);
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < READERS; ++t) {
+        readers.emplace_back([&, t] {
+            std::default_random_engine dre(t);
+            std::size_t last = 0;
+            while (true) {
+                int n = inserted.load(std::memory_order_acquire);
+                for (int i = 0; i < 64 && n; ++i) {
+                    int key = keys[dre() % n];
+                    auto it = sls.find(key);
+                    if (it == sls.end() || *it != key) {
+                        ++failures;
+                    }
+                }
+
+                std::size_t count = 0;
+                int prev = -1;
+                for (auto it = sls.begin(); it != sls.end(); ++it) {
+                    if (*it <= prev) {
+                        ++failures;
+                    }
+                    prev = *it;
+                    ++count;
+                }
+                if (count < last || count < (std::size_t)n) {
+                    ++failures;
+                }
+                last = count;
+                if (n == N) {
+                    break;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < N; ++i) {
+        sls.insert_unique(keys[i]);
+        inserted.store(i + 1, std::memory_order_release);
+    }
+    for (auto &t : readers) {
+        t.join();
+    }
+
+    ASSERT_EQ(0, failures.load());
+    ASSERT_EQ((std::size_t)N, sls.size());
+}
+
+TEST(published, case1) {
+    test_concurrent_readers<bit::sl_published_set<int>>();
+    test_concurrent_readers<bit::sl_published_set<int, BottomPublishedLinkPolicy>>();
+}
+
+TEST(published, case2) {
+    constexpr int N = 1 << 12;
+
+    {
+        bit::sl_published_set<int> sls;
+        sls.enable_epoch();
+        for (int i = 0; i < N; ++i) {
+            sls.insert_equal(i);
+        }
+
+        auto guard = sls.pin();
+        auto it = sls.find(N / 2);
+        for (int i = N / 2 + 8; i >= N / 2; --i) {
+            sls.erase(sls.find(i));
+        }
+        ASSERT_EQ(N / 2, *it);
+
+        int prev = *it, count = 0;
+        for (++it; it != sls.end() && count <= N; ++it, ++count) {
+            ASSERT_LT(prev, *it);
+            prev = *it;
+        }
+        ASSERT_EQ(N - 1, prev);
+        ASSERT_LE(N / 2 - 9, count);
+    }
+
+    bit::sl_published_set<int> sls;
+    sls.enable_epoch();
+    for (int i = 0; i < N; ++i) {
+        sls.insert_equal(i);
+    }
+
+    std::vector<int> evens;
+    for (int i = 0; i < N; i += 2) {
+        evens.push_back(i);
+    }
+    std::shuffle(evens.begin(), evens.end(), std::mt19937(0));
+
+    std::atomic<bool> done(false);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_acquire)) {
+                auto guard = sls.pin();
+                int prev = -1, odd = 0, steps = 0;
+                for (auto it = sls.begin(); it != sls.end() && steps <= N; ++it, ++steps) {
+                    if (*it <= prev) {
+                        ++failures;
+                    }
+                    prev = *it;
+                    odd += prev & 1;
+                }
+                if (odd != N / 2) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (const auto &i : evens) {
+        if (i & 2) {
+            sls.erase(i);
+        } else {
+            sls.erase(sls.find(i));
+        }
+    }
+    done.store(true, std::memory_order_release);
+    for (auto &t : readers) {
+        t.join();
+    }
+    for (int i = 0; i < 3; ++i) {
+        sls.reclaim();
+    }
+
+    ASSERT_EQ(0, failures.load());
+    ASSERT_EQ((std::size_t)N / 2, sls.size());
+    ASSERT_EQ(0, sls.retired());
+}
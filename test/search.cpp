@@ -113,4 +113,89 @@ TEST(find, case0) {
             ASSERT_EQ(*tmp, i);
         }
     }
-}
\ No newline at end of file
+}
+
+TEST(find_many, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls(rv.begin(), rv.end());
+
+        bit::vec_t keys;
+        for (const auto &i : uv) {
+            for (int j = -1; j <= 1; ++j) {
+                keys.emplace_back(i.value + j);
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+
+        std::vector<bit::sl_set<bit::TestClass>::iterator> lbs;
+        sls.lower_bound_many(keys.begin(), keys.end(), std::back_inserter(lbs));
+        ASSERT_EQ(keys.size(), lbs.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(sls.lower_bound(keys[i]), lbs[i]);
+        }
+
+        std::vector<bit::sl_set<bit::TestClass>::iterator> fs(keys.size());
+        auto out = sls.find_many(keys.begin(), keys.end(), fs.begin());
+        ASSERT_EQ(fs.end(), out);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(sls.find(keys[i]), fs[i]);
+        }
+
+        std::reverse(keys.begin(), keys.end());
+        fs.clear();
+        sls.find_many(keys.begin(), keys.end(), std::back_inserter(fs));
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(sls.find(keys[i]), fs[i]);
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(find_interleaved, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_set<bit::TestClass> sls;
+
+        bit::vec_t keys;
+        for (const auto &i : uv) {
+            for (int j = -1; j <= 1; ++j) {
+                keys.emplace_back(i.value + j);
+            }
+        }
+        std::shuffle(keys.begin(), keys.end(), std::mt19937(0));
+
+        std::vector<bit::sl_set<bit::TestClass>::iterator> out;
+        sls.find_interleaved(keys.begin(), keys.end(), std::back_inserter(out));
+        ASSERT_EQ(keys.size(), out.size());
+        for (const auto &i : out) {
+            ASSERT_EQ(sls.end(), i);
+        }
+
+        sls.insert_equal(rv.begin(), rv.end());
+
+        out.clear();
+        sls.lower_bound_interleaved(keys.begin(), keys.end(), std::back_inserter(out));
+        ASSERT_EQ(keys.size(), out.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(sls.lower_bound(keys[i]), out[i]);
+        }
+
+        out.clear();
+        sls.find_interleaved<3>(keys.begin(), keys.end(), std::back_inserter(out));
+        ASSERT_EQ(keys.size(), out.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            ASSERT_EQ(sls.find(keys[i]), out[i]);
+        }
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
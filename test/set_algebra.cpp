@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+template <typename T, typename LinkPolicy>
+using sl_policy_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, LinkPolicy>;
+
+template <typename SL>
+static void check_indexed(const SL &sls, const bit::vec_t &v) {
+    bit::check_equal(sls, v);
+
+    if constexpr (SL::link_policy::indexed) {
+        std::size_t i = 0;
+        for (auto it = sls.begin(); it != sls.end(); ++it, ++i) {
+            ASSERT_EQ(it, sls.nth(i));
+            ASSERT_EQ(i, sls.rank(it));
+        }
+    }
+
+    for (const auto &i : v) {
+        ASSERT_TRUE(sls.contain(i));
+    }
+}
+
+/*
+ * 偶数下标的元素放入 a，3 的倍数下标的元素放入 b，二者有交集也各有独有的元素
+ */
+template <typename SL>
+static void test_set_algebra() {
+    auto sv = bit::get_sorted_vector(1024);
+    bit::vec_t av, bv;
+    for (std::size_t i = 0; i < sv.size(); ++i) {
+        if (i % 2 == 0) {
+            av.push_back(sv[i]);
+        }
+        if (i % 3 == 0) {
+            bv.push_back(sv[i]);
+        }
+    }
+    bit::TestClass::reset();
+
+    {
+        SL a(av.begin(), av.end());
+        SL b(bv.begin(), bv.end());
+
+        bit::vec_t v;
+        std::set_union(av.begin(), av.end(), bv.begin(), bv.end(), std::back_inserter(v));
+        SL c(a);
+        c.set_union(b);
+        check_indexed(c, v);
+        check_indexed(b, bv);
+
+        v.clear();
+        std::set_intersection(av.begin(), av.end(), bv.begin(), bv.end(), std::back_inserter(v));
+        c = a;
+        c.set_intersection(b);
+        check_indexed(c, v);
+
+        v.clear();
+        std::set_difference(av.begin(), av.end(), bv.begin(), bv.end(), std::back_inserter(v));
+        c = a;
+        c.set_difference(b);
+        check_indexed(c, v);
+        c.set_difference(c);
+        ASSERT_TRUE(c.empty());
+
+        v.clear();
+        std::merge(av.begin(), av.end(), bv.begin(), bv.end(), std::back_inserter(v));
+        a.merge(b);
+        check_indexed(a, v);
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(b.end(), b.begin());
+
+        /* 被取空的表可以继续使用 */
+        b.insert_equal(sv.begin(), sv.end());
+        check_indexed(b, sv);
+        b.merge(c);
+        check_indexed(b, sv);
+        c.merge(b);
+        check_indexed(c, sv);
+        ASSERT_TRUE(b.empty());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(set_algebra, case0) {
+    test_set_algebra<bit::sl_set<bit::TestClass>>();
+    test_set_algebra<bit::sl_indexed_set<bit::TestClass>>();
+    test_set_algebra<sl_policy_set<bit::TestClass, bit::BottomBackwardLinkPolicy>>();
+    test_set_algebra<sl_policy_set<bit::TestClass, bit::ForwardLinkPolicy>>();
+}
+
+TEST(set_algebra, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        bit::sl_indexed_set<bit::TestClass> a(rv.begin(), rv.end());
+        bit::sl_indexed_set<bit::TestClass> b(uv.begin(), uv.end());
+        bit::sl_indexed_set<bit::TestClass> c(a);
+        auto copy_ctor = bit::TestClass::copy_ctor;
+        auto move_ctor = bit::TestClass::move_ctor;
+
+        /* 合并只移动节点，不复制也不移动元素 */
+        a.merge(b);
+        ASSERT_EQ(copy_ctor, bit::TestClass::copy_ctor);
+        ASSERT_EQ(move_ctor, bit::TestClass::move_ctor);
+
+        /* 多重集合语义：每个元素最多与另一表中的一个相等元素配对 */
+        bit::vec_t v(a.begin(), a.end());
+        copy_ctor = bit::TestClass::copy_ctor;
+        c.set_union(a);
+        check_indexed(c, v);
+        ASSERT_EQ(copy_ctor + v.size() - rv.size(), bit::TestClass::copy_ctor);
+
+        c.set_difference(a);
+        ASSERT_TRUE(c.empty());
+        ASSERT_EQ(0, c.height());
+
+        c.insert_equal(uv.begin(), uv.end());
+        c.set_intersection(a);
+        check_indexed(c, uv);
+        c.erase(c.begin(), c.end());
+        ASSERT_TRUE(c.empty());
+    }
+
+    {
+        bit::SkipList<bit::TestClass, bit::TestClass,
+            std::_Identity<bit::TestClass>, std::less<bit::TestClass>, 32,
+            std::allocator<bit::TestClass>> a(rv.begin(), rv.end()), b(uv.begin(), uv.end());
+        a.merge(b);
+        ASSERT_EQ(rv.size() + uv.size(), a.size());
+        ASSERT_TRUE(std::is_sorted(a.begin(), a.end()));
+        ASSERT_TRUE(b.empty());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
@@ -0,0 +1,197 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#include "util.hpp"
+#include "sharded_skip_list.hpp"
+
+template <typename T>
+using ssl_set = bit::ShardedSkipList<T, T, std::_Identity<T>, std::less<T>>;
+
+static std::vector<bit::TestClass> get_bounds() {
+    constexpr int Q = std::numeric_limits<int>::max() / 4;
+    /* 2 * Q 与 2 * Q + 1 之间的分片几乎总是空的 */
+    return { Q, 2 * Q, 2 * Q + 1, 3 * Q };
+}
+
+template <typename SL>
+static void check_scan(const SL &sls, const bit::vec_t &v) {
+    bit::check_equal(sls, v);
+
+    bit::vec_t content;
+    sls.for_each([&content](const bit::TestClass &i) {
+        content.push_back(i);
+    });
+    ASSERT_EQ(v, content);
+}
+
+TEST(sharded, case0) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        ssl_set<bit::TestClass> sls(get_bounds());
+        ASSERT_EQ(5, sls.shard_count());
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        check_scan(sls, sv);
+        bit::check_search(sls, sv, uv);
+
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            for (std::size_t j = i; j < uv.size() && j < i + 64; j += 16) {
+                auto first = std::lower_bound(sv.begin(), sv.end(), uv[i]);
+                auto last = std::lower_bound(sv.begin(), sv.end(), uv[j]);
+                bit::vec_t content;
+                sls.scan(uv[i], uv[j], [&content](const bit::TestClass &v) {
+                    content.push_back(v);
+                });
+                ASSERT_EQ(bit::vec_t(first, last), content);
+            }
+        }
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            std::size_t n = std::count(sv.begin(), sv.end(), uv[i]);
+            ASSERT_FALSE(sls.insert_unique(uv[i]));
+            if (i % 2) {
+                ASSERT_EQ(n, sls.erase(uv[i]));
+                ASSERT_EQ(0, sls.erase(uv[i]));
+            } else {
+                remain.insert(remain.end(), n, uv[i]);
+            }
+        }
+        check_scan(sls, remain);
+
+        sls.clear();
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(sls.end(), sls.begin());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(sharded, case1) {
+    auto rv = bit::get_random_vector(4096);
+    auto sv = bit::get_sorted_vector(4096);
+    auto uv = bit::get_unique_vector(4096);
+    bit::TestClass::reset();
+
+    {
+        ssl_set<bit::TestClass> sls;
+        sls.set_max_shard_size(512);
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        ASSERT_GE(sls.shard_count(), 8);
+        auto bounds = sls.bounds();
+        for (std::size_t i = 0; i < sls.shard_count(); ++i) {
+            ASSERT_LE(sls.shard_size(i), 512);
+        }
+        ASSERT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+        check_scan(sls, sv);
+        bit::check_search(sls, sv, uv);
+
+        /* 删除大部分元素后合并过小的分片 */
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            if (i % 16) {
+                sls.erase(uv[i]);
+            } else {
+                std::size_t n = std::count(sv.begin(), sv.end(), uv[i]);
+                remain.insert(remain.end(), n, uv[i]);
+            }
+        }
+        std::size_t shards = sls.shard_count();
+        sls.rebalance();
+        ASSERT_LT(sls.shard_count(), shards);
+        check_scan(sls, remain);
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(sharded, case2) {
+    constexpr int THREADS = 4;
+    constexpr int N = 1 << 14;
+
+    ssl_set<int> sls({ N / 4, N / 2, 3 * N / 4 });
+    sls.set_max_shard_size(N / 8);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&sls, t] {
+            for (int i = t; i < N; i += THREADS) {
+                sls.insert_unique(i);
+            }
+            for (int i = t; i < N; i += 2 * THREADS) {
+                sls.erase(i);
+            }
+            for (int i = t; i < N; i += THREADS) {
+                int prev = -1;
+                sls.scan(i, i + 64, [&prev](int v) {
+                    EXPECT_LT(prev, v);
+                    prev = v;
+                });
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    std::vector<int> remain;
+    for (int i = 0; i < N; ++i) {
+        if (i % (2 * THREADS) >= THREADS) {
+            remain.push_back(i);
+        }
+    }
+    ASSERT_EQ(remain.size(), sls.size());
+    ASSERT_TRUE(std::equal(remain.begin(), remain.end(), sls.begin(), sls.end()));
+    ASSERT_GE(sls.shard_count(), 8);
+
+    /* 写入集中在最后一个分片时将其拆分；关闭按大小拆分，并先清零并发阶段留下的写入计数 */
+    sls.set_max_shard_size(0);
+    sls.rebalance();
+    int first = sls.bounds().back();
+    for (int i = 0; i < 1024; ++i) {
+        sls.insert_unique(N + i);
+    }
+    sls.rebalance();
+    ASSERT_LT(first, sls.bounds().back());
+}
+
+TEST(sharded, case3) {
+    /* 查找与 rebalance() 并发：分片边界与分片数组在布局锁下读取 */
+    constexpr int N = 1 << 12;
+
+    ssl_set<int> sls;
+    for (int i = 0; i < N; i += 2) {
+        sls.insert_unique(i);
+    }
+
+    std::atomic<bool> stop(false);
+    std::thread reader([&sls, &stop] {
+        while (!stop.load()) {
+            for (int i = 0; i < N; i += 64) {
+                EXPECT_NE(sls.end(), sls.lower_bound(i));
+                EXPECT_NE(sls.end(), sls.upper_bound(i));
+                EXPECT_NE(sls.end(), sls.find(i - i % 2));
+            }
+        }
+    });
+
+    for (int n = N / 2; n >= 16; n /= 2) {
+        sls.set_max_shard_size(n);
+        sls.rebalance();
+    }
+    stop.store(true);
+    reader.join();
+
+    ASSERT_GE(sls.shard_count(), 8);
+    ASSERT_EQ(sls.end(), sls.find(1));
+    ASSERT_EQ(N - 2, *sls.lower_bound(N - 2));
+    ASSERT_EQ(sls.end(), sls.upper_bound(N - 2));
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include "util.hpp"
+
+template <typename T, typename LinkPolicy>
+using sl_policy_set = bit::SkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    bit::SkipListPool<T>, LinkPolicy>;
+
+template <typename SL>
+static void check_indexed(const SL &sls, bit::vec_t::const_iterator first,
+                          bit::vec_t::const_iterator last) {
+    bit::check_equal(sls, first, last);
+
+    if constexpr (SL::link_policy::indexed) {
+        std::size_t i = 0;
+        for (auto it = sls.begin(); it != sls.end(); ++it, ++i) {
+            ASSERT_EQ(it, sls.nth(i));
+            ASSERT_EQ(i, sls.rank(it));
+        }
+    }
+
+    for (auto p = first; p != last; ++p) {
+        ASSERT_TRUE(sls.contain(*p));
+    }
+}
+
+template <typename SL>
+static void test_split_join() {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        SL sls(rv.begin(), rv.end());
+        std::unordered_set<const bit::TestClass *> addrs;
+        for (const auto &i : sls) {
+            addrs.insert(&i);
+        }
+        auto copy_ctor = bit::TestClass::copy_ctor;
+        auto move_ctor = bit::TestClass::move_ctor;
+
+        for (std::size_t i = 0; i < uv.size(); i += 97) {
+            auto cut = std::lower_bound(sv.begin(), sv.end(), uv[i]);
+            SL upper = sls.split(uv[i]);
+            check_indexed(sls, sv.cbegin(), cut);
+            check_indexed(upper, cut, sv.cend());
+
+            sls.join(upper);
+            ASSERT_TRUE(upper.empty());
+            check_indexed(sls, sv.cbegin(), sv.cend());
+        }
+
+        /* 切分到空表与从空表切分 */
+        SL upper = sls.split(sv.front());
+        ASSERT_TRUE(sls.empty());
+        ASSERT_EQ(0, sls.height());
+        ASSERT_TRUE(upper.split(bit::TestClass(sv.back().value + 1)).empty());
+        sls.join(upper);
+        check_indexed(sls, sv.cbegin(), sv.cend());
+
+        /* 元素留在原处，没有被复制或移动 */
+        for (const auto &i : sls) {
+            ASSERT_EQ(1, addrs.count(&i));
+        }
+        ASSERT_EQ(copy_ctor, bit::TestClass::copy_ctor);
+        ASSERT_EQ(move_ctor, bit::TestClass::move_ctor);
+
+        /* 原表先于切出的表销毁，切出的表仍可继续插入与删除 */
+        auto cut = std::lower_bound(sv.begin(), sv.end(), uv[uv.size() / 2]);
+        SL tmp(std::move(sls));
+        upper = tmp.split(uv[uv.size() / 2]);
+        tmp.clear();
+        check_indexed(upper, cut, sv.cend());
+        upper.erase(sv.back());
+        upper.insert_equal(sv.back());
+        upper.insert_equal(sv.begin(), cut);
+        check_indexed(upper, sv.cbegin(), sv.cend());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(split, case0) {
+    test_split_join<bit::sl_set<bit::TestClass>>();
+    test_split_join<bit::sl_indexed_set<bit::TestClass>>();
+    test_split_join<sl_policy_set<bit::TestClass, bit::BottomBackwardLinkPolicy>>();
+    test_split_join<sl_policy_set<bit::TestClass, bit::ForwardLinkPolicy>>();
+}
+
+TEST(split, case1) {
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        /* 反复切分与拼接，两个表共同持有的 slab 在拼接时合并 */
+        bit::sl_indexed_set<bit::TestClass> sls(sv.begin(), sv.end());
+        for (int i = 0; i < 16; ++i) {
+            auto upper = sls.split(uv[uv.size() / 2]);
+            auto lower = std::move(sls);
+            sls = upper.split(uv[uv.size() / 4 * 3]);
+            upper.join(sls);
+            lower.join(upper);
+            sls = std::move(lower);
+        }
+        check_indexed(sls, sv.cbegin(), sv.cend());
+    }
+
+    {
+        bit::SkipList<bit::TestClass, bit::TestClass,
+            std::_Identity<bit::TestClass>, std::less<bit::TestClass>, 32,
+            std::allocator<bit::TestClass>> sls(sv.begin(), sv.end());
+        auto upper = sls.split(uv[uv.size() / 2]);
+        auto cut = std::lower_bound(sv.begin(), sv.end(), uv[uv.size() / 2]);
+        check_indexed(sls, sv.cbegin(), cut);
+        check_indexed(upper, cut, sv.cend());
+        sls.join(upper);
+        check_indexed(sls, sv.cbegin(), sv.cend());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
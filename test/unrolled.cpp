@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "util.hpp"
+#include "unrolled_skip_list.hpp"
+
+template <typename T, std::size_t ChunkBytes = 256>
+using usl_set = bit::UnrolledSkipList<T, T, std::_Identity<T>, std::less<T>, 32,
+    ChunkBytes>;
+
+template <typename SL>
+static void test_insert_erase() {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        SL sls;
+        for (const auto &i : rv) {
+            sls.insert_equal(i);
+        }
+        bit::check_equal(sls, sv);
+        bit::check_search(sls, sv, uv);
+
+        bit::vec_t remain;
+        for (std::size_t i = 0; i < uv.size(); ++i) {
+            auto n = std::count(sv.begin(), sv.end(), uv[i]);
+            if (i % 3) {
+                ASSERT_EQ(n, sls.count(uv[i]));
+                ASSERT_EQ(sls.upper_bound(uv[i]), sls.erase(uv[i]));
+                ASSERT_FALSE(sls.contain(uv[i]));
+            } else {
+                remain.insert(remain.end(), n, uv[i]);
+            }
+        }
+        bit::check_equal(sls, remain);
+        bit::check_search(sls, remain, uv);
+
+        while (!sls.empty()) {
+            sls.erase(sls.begin());
+        }
+        ASSERT_EQ(0, sls.chunk_count());
+        ASSERT_EQ(0, sls.height());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(unrolled, case0) {
+    test_insert_erase<usl_set<bit::TestClass>>();
+    test_insert_erase<usl_set<bit::TestClass, 16>>();
+}
+
+TEST(unrolled, case1) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        usl_set<bit::TestClass, 16> sls;
+        for (const auto &i : rv) {
+            bool absent = sls.end() == sls.find(i);
+            ASSERT_EQ(absent, sls.insert_unique(i).second);
+        }
+        bit::check_equal(sls, uv);
+
+        using iterator = typename decltype(sls)::iterator;
+        ASSERT_EQ(std::make_pair(iterator(), false), sls.insert_unique(uv[0]));
+        ASSERT_EQ(std::make_pair(iterator(), false), sls.emplace_unique(uv[1].value));
+        ASSERT_EQ(sls.end(), sls.erase(bit::TestClass(uv.back().value + 1)));
+
+        auto first = sls.lower_bound(uv[uv.size() / 4]);
+        auto last = sls.lower_bound(uv[uv.size() / 2]);
+        auto it = sls.erase(first, last);
+        ASSERT_EQ(uv[uv.size() / 2], *it);
+
+        bit::vec_t remain(uv.begin(), uv.begin() + uv.size() / 4);
+        remain.insert(remain.end(), uv.begin() + uv.size() / 2, uv.end());
+        bit::check_equal(sls, remain);
+
+        sls.erase(sls.begin(), sls.end());
+        ASSERT_TRUE(sls.empty());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(unrolled, case2) {
+    auto rv = bit::get_random_vector(1024);
+    auto sv = bit::get_sorted_vector(1024);
+    auto uv = bit::get_unique_vector(1024);
+    bit::TestClass::reset();
+
+    {
+        usl_set<bit::TestClass> sls;
+        sls.assign_sorted(sv.begin(), sv.end());
+        bit::check_equal(sls, sv);
+        bit::check_search(sls, sv, uv);
+        ASSERT_LT(sls.chunk_count(), sv.size() / 16);
+
+        usl_set<bit::TestClass> other(sls);
+        bit::check_equal(other, sv);
+
+        usl_set<bit::TestClass> moved(std::move(other));
+        bit::check_equal(moved, sv);
+        ASSERT_TRUE(other.empty());
+
+        other = moved;
+        bit::check_equal(other, sv);
+        moved = std::move(sls);
+        bit::check_equal(moved, sv);
+
+        moved.insert_equal(rv.begin(), rv.end());
+        ASSERT_EQ(2 * sv.size(), moved.size());
+        moved.clear();
+        ASSERT_TRUE(moved.empty());
+        ASSERT_EQ(moved.end(), moved.begin());
+    }
+
+    ASSERT_TRUE(bit::TestClass::check());
+}
+
+TEST(unrolled, case3) {
+    /* 参数引用表中的元素，插入时节点分裂与元素移动不影响插入的值 */
+    using set_type = usl_set<std::string, 128>;
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < set_type::CHUNK_CAPACITY; ++i) {
+        keys.push_back(std::string(64, 'a' + i));
+    }
+
+    for (std::size_t k = 0; k < keys.size(); ++k) {
+        for (int emplace = 0; emplace < 2; ++emplace) {
+            set_type sls(keys.begin(), keys.end());
+            ASSERT_EQ(1, sls.chunk_count());
+
+            if (emplace) {
+                sls.emplace_equal(*sls.find(keys[k]));
+            } else {
+                sls.insert_equal(*sls.find(keys[k]));
+            }
+
+            std::vector<std::string> expect(keys);
+            expect.insert(expect.begin() + k, keys[k]);
+            ASSERT_TRUE(std::equal(expect.begin(), expect.end(), sls.begin(), sls.end()));
+        }
+    }
+}